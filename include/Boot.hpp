@@ -0,0 +1,63 @@
+#ifndef GBEMU_BOOT_HPP
+#define GBEMU_BOOT_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "cpu/CPU.hpp"
+#include "memory/MemoryMap.hpp"
+#include "memory/IOSegment.hpp"
+#include "Timer.hpp"
+
+namespace GameBoy
+{
+
+/**
+ * Boot ROM overlay (BOOT 0xFF50)
+ *
+ * The 256-byte DMG boot ROM is mapped over 0x0000-0x00FF, the 2304-byte CGB
+ * one over 0x0000-0x00FF and 0x0200-0x08FF, leaving the cartridge header in
+ * between visible. The first nonzero write to 0xFF50 unmaps it until the next
+ * power cycle; the CPU is expected to start at 0x0000.
+ */
+class BootROM : public IODevice
+{
+public:
+    static const uint16_t BOOTAddress = 0xFF50;
+    static const uint32_t DMGSize = 0x100;
+    static const uint32_t CGBSize = 0x900;
+
+private:
+    MemoryMap& mmap;
+    IOSegment *segment;
+
+    std::vector<uint8_t> contents;
+    MemorySegment *lowSegment;
+    MemorySegment *highSegment;
+    bool mapped;
+
+    void Unmap(void);
+
+public:
+    BootROM(MemoryMap& mmap, const std::string& path);
+    ~BootROM();
+
+    inline bool IsColor(void) const { return this->contents.size() == CGBSize; }
+    inline bool IsMapped(void) const { return this->mapped; }
+
+    uint8_t ReadRegister(uint16_t address);
+    void WriteRegister(uint16_t address, uint8_t byte);
+};
+
+/**
+ * Skips the boot ROM: leaves the registers, the I/O registers, the divider
+ * and the DMG logo in VRAM as the DMG or CGB boot ROM would hand a CGB game
+ * (or any game on DMG) over at 0x0100. The cartridge must already be mapped,
+ * its header decides the flags and the logo, and all the devices created.
+ */
+void FastBoot(MemoryMap& mmap, CPU& cpu, Timer& timer, bool color);
+
+};
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef GBEMU_DMA_HPP
+#define GBEMU_DMA_HPP
+
+#include "cpu/CPU.hpp"
+#include "memory/MemoryMap.hpp"
+#include "memory/IOSegment.hpp"
+
+namespace GameBoy
+{
+
+/**
+ * OAM DMA controller (0xFF46)
+ *
+ * Writing XX to the register copies XX00-XX9F into OAM. On hardware the
+ * transfer moves one byte per M-cycle over 160 M-cycles, during which the CPU
+ * can only reach HRAM. Since nothing but the CPU could modify the source in
+ * that window, the copy itself is always done in one bulk transfer; the
+ * accurate mode only adds the bus lock.
+ */
+class DMA : public IODevice
+{
+public:
+    enum TimingMode {
+        TimingFast,
+        TimingAccurate
+    };
+
+    static const uint16_t OAMBase = 0xFE00;
+    static const uint16_t TransferSize = 0xA0;
+    /* One M-cycle of startup, then one M-cycle per byte */
+    static const uint64_t TransferCycles = 4 + TransferSize * 4;
+
+private:
+    MemoryMap& mmap;
+    CPU& cpu;
+    IOSegment *segment;
+
+    enum TimingMode mode;
+    uint8_t source;
+
+public:
+    DMA(MemoryMap& mmap, CPU& cpu, enum TimingMode mode = TimingAccurate)
+    : mmap(mmap), cpu(cpu), mode(mode), source(0xFF)
+    {
+        this->segment = new IOSegment("DMA", 0xFF46, 0xFF47, this);
+        this->mmap.AddSegment(this->segment);
+    }
+
+    ~DMA()
+    {
+        delete this->segment;
+    }
+
+    inline void SetTimingMode(enum TimingMode mode) { this->mode = mode; }
+    inline enum TimingMode GetTimingMode(void) const { return this->mode; }
+
+    uint8_t ReadRegister(uint16_t)
+    {
+        return this->source;
+    }
+
+    void WriteRegister(uint16_t, uint8_t byte)
+    {
+        this->source = byte;
+
+        /* Sources above WRAM hit the echo RAM mirror */
+        uint16_t address = byte << 8;
+        if (address >= 0xE000)
+            address -= 0x2000;
+
+        uint8_t buffer[TransferSize];
+        this->mmap.Load(address, buffer, TransferSize);
+        this->mmap.Write(OAMBase, buffer, TransferSize);
+
+        if (this->mode == TimingAccurate)
+            this->cpu.LockBus(TransferCycles);
+    }
+};
+
+};
+
+#endif
\ No newline at end of file
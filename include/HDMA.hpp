@@ -0,0 +1,59 @@
+#ifndef GBEMU_HDMA_HPP
+#define GBEMU_HDMA_HPP
+
+#include <cstdint>
+
+#include "cpu/CPU.hpp"
+#include "memory/MemoryMap.hpp"
+#include "memory/IOSegment.hpp"
+#include "Video.hpp"
+
+namespace GameBoy
+{
+
+/**
+ * CGB VRAM DMA (HDMA1-HDMA5 0xFF51-0xFF55)
+ *
+ * A general purpose transfer copies everything at once when HDMA5 is
+ * written, an HBlank transfer copies one block at the start of every HBlank.
+ * Blocks go through the memory map, so into the VRAM bank currently
+ * selected, and halt the CPU for BlockCycles each.
+ */
+class HDMA : public IODevice, public HBlankListener
+{
+public:
+    static const uint16_t HDMA1Address = 0xFF51;
+    static const uint16_t HDMA5Address = 0xFF55;
+
+    static const uint16_t BlockSize = 0x10;
+    /* 8 M-cycles in normal speed, 16 in double speed */
+    static const uint64_t BlockCycles = 32;
+
+private:
+    MemoryMap& mmap;
+    CPU& cpu;
+    Video& video;
+    IOSegment *segment;
+
+    uint16_t source;
+    uint16_t destination;
+
+    /* Blocks left minus one, as read from HDMA5 */
+    uint8_t remaining;
+    bool active;
+
+    void CopyBlock(void);
+
+public:
+    HDMA(MemoryMap& mmap, CPU& cpu, Video& video);
+    ~HDMA();
+
+    uint8_t ReadRegister(uint16_t address);
+    void WriteRegister(uint16_t address, uint8_t byte);
+
+    void OnHBlank(uint64_t now);
+};
+
+};
+
+#endif
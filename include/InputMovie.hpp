@@ -0,0 +1,78 @@
+#ifndef GBEMU_INPUT_MOVIE_HPP
+#define GBEMU_INPUT_MOVIE_HPP
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+namespace GameBoy
+{
+
+/**
+ * Recorded joypad input
+ *
+ * A movie file is an InputMovieHeader followed by InputRecords sorted by
+ * time, each holding the complete button mask from that time on. Times are
+ * cycles, or frames with InputMovieFrames, which are easier to write by hand
+ * or convert from other emulators. Records go through the file once, so it
+ * is mapped and left to the kernel to read ahead.
+ */
+
+enum InputMovieFlags : uint16_t {
+    InputMovieFrames = 0x0001,
+};
+
+struct InputMovieHeader {
+    char magic[4];          /* "GBIM" */
+    uint16_t version;
+    uint16_t flags;
+    uint32_t recordSize;
+    uint32_t reserved;
+};
+
+struct InputRecord {
+    uint64_t time;
+    uint8_t buttons;
+    uint8_t reserved[7];
+};
+
+static_assert(sizeof(InputRecord) == 16, "InputRecord must stay packed");
+
+class InputMovieReader
+{
+private:
+    const uint8_t *data;
+    size_t size;
+
+    const InputRecord *records;
+    size_t nRecords;
+    size_t position;
+    bool frames;
+
+public:
+    InputMovieReader(const std::string& path);
+    ~InputMovieReader();
+
+    inline bool IsInFrames(void) const { return this->frames; }
+    inline bool AtEnd(void) const { return this->position == this->nRecords; }
+
+    inline const InputRecord& Peek(void) const { return this->records[this->position]; }
+    inline void Advance(void) { this->position++; }
+};
+
+/* Records are small and rare, stdio buffering is enough */
+class InputMovieWriter
+{
+private:
+    FILE *file;
+
+public:
+    InputMovieWriter(const std::string& path, bool frames = false);
+    ~InputMovieWriter();
+
+    void Append(uint64_t time, uint8_t buttons);
+};
+
+};
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef GBEMU_JOYPAD_HPP
+#define GBEMU_JOYPAD_HPP
+
+#include <cstdint>
+
+#include "cpu/CPU.hpp"
+#include "cpu/InterruptController.hpp"
+#include "memory/MemoryMap.hpp"
+#include "memory/IOSegment.hpp"
+#include "InputMovie.hpp"
+#include "Scheduler.hpp"
+
+namespace GameBoy
+{
+
+/**
+ * Joypad (P1 0xFF00)
+ *
+ * Buttons are a mask laid out like the two P1 line groups, directions in the
+ * low nibble and buttons in the high one, 1 meaning pressed. The joypad
+ * interrupt is requested whenever a P1 input line falls, either because a
+ * button was pressed or because a group with a pressed button got selected.
+ *
+ * While a movie plays, its records are applied at their exact cycle from a
+ * scheduler event, so playback does not depend on how the owner runs the CPU.
+ * Button changes are appended to the recorder if any.
+ */
+class Joypad : public IODevice, public Schedulable
+{
+public:
+    static const uint16_t P1Address = 0xFF00;
+
+    enum Button : uint8_t {
+        ButtonRight  = 0x01,
+        ButtonLeft   = 0x02,
+        ButtonUp     = 0x04,
+        ButtonDown   = 0x08,
+        ButtonA      = 0x10,
+        ButtonB      = 0x20,
+        ButtonSelect = 0x40,
+        ButtonStart  = 0x80
+    };
+
+private:
+    MemoryMap& mmap;
+    CPU& cpu;
+    InterruptController& interruptController;
+    IOSegment *segment;
+    int eventId;
+
+    /* Bits 5-4 of P1 */
+    uint8_t select;
+    uint8_t buttons;
+
+    InputMovieReader *movie;
+    InputMovieWriter *recorder;
+
+    /* Bits 3-0 of P1, 0 meaning pressed in a selected group */
+    inline uint8_t GetLines(void) const
+    {
+        uint8_t pressed = 0;
+        if (!(this->select & 0x10))
+            pressed |= this->buttons & 0x0F;
+        if (!(this->select & 0x20))
+            pressed |= this->buttons >> 4;
+        return ~pressed & 0x0F;
+    }
+
+    void Update(uint8_t select, uint8_t buttons);
+    void ScheduleMovie(void);
+
+public:
+    Joypad(MemoryMap& mmap, CPU& cpu, InterruptController& interruptController);
+    ~Joypad();
+
+    inline uint8_t GetButtons(void) const { return this->buttons; }
+    void SetButtons(uint8_t buttons);
+
+    /* Plays movie from the current cycle on, records already past are skipped */
+    void SetMovie(InputMovieReader *movie);
+    inline void SetRecorder(InputMovieWriter *recorder) { this->recorder = recorder; }
+
+    uint8_t ReadRegister(uint16_t address);
+    void WriteRegister(uint16_t address, uint8_t byte);
+
+    void OnEvent(uint64_t deadline);
+};
+
+};
+
+#endif
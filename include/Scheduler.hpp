@@ -0,0 +1,166 @@
+#ifndef GBEMU_SCHEDULER_HPP
+#define GBEMU_SCHEDULER_HPP
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace GameBoy
+{
+
+/* Device reacting to a deadline it scheduled */
+class Schedulable
+{
+public:
+    virtual ~Schedulable() {}
+
+    /* Called once the CPU reaches the deadline, with the deadline itself */
+    virtual void OnEvent(uint64_t deadline) = 0;
+};
+
+/**
+ * Min-heap of device deadlines, keyed on the CPU cycle counter.
+ *
+ * Each registered device owns one event slot which can be (re)scheduled or
+ * cancelled at any time. The CPU only has to compare its cycle counter to
+ * GetNextDeadline() to know whether anything needs to run.
+ */
+class Scheduler
+{
+public:
+    static const uint64_t Never = UINT64_MAX;
+
+private:
+    struct Event {
+        uint64_t deadline;
+        Schedulable *handler;
+        int heapIndex;
+    };
+
+    std::vector<Event> events;
+    std::vector<int> heap;
+    uint64_t nextDeadline;
+
+    inline uint64_t DeadlineAt(size_t i) const
+    {
+        return this->events[this->heap[i]].deadline;
+    }
+
+    inline void Swap(size_t i, size_t j)
+    {
+        std::swap(this->heap[i], this->heap[j]);
+        this->events[this->heap[i]].heapIndex = i;
+        this->events[this->heap[j]].heapIndex = j;
+    }
+
+    void SiftUp(size_t i)
+    {
+        while (i > 0) {
+            size_t parent = (i - 1) / 2;
+            if (this->DeadlineAt(parent) <= this->DeadlineAt(i))
+                break;
+            this->Swap(i, parent);
+            i = parent;
+        }
+    }
+
+    void SiftDown(size_t i)
+    {
+        size_t n = this->heap.size();
+        while (true) {
+            size_t smallest = i;
+            size_t left = 2 * i + 1;
+            size_t right = left + 1;
+
+            if (left < n && this->DeadlineAt(left) < this->DeadlineAt(smallest))
+                smallest = left;
+            if (right < n && this->DeadlineAt(right) < this->DeadlineAt(smallest))
+                smallest = right;
+            if (smallest == i)
+                break;
+
+            this->Swap(i, smallest);
+            i = smallest;
+        }
+    }
+
+    inline void UpdateNextDeadline(void)
+    {
+        this->nextDeadline = this->heap.empty() ? Never : this->DeadlineAt(0);
+    }
+
+public:
+    Scheduler() : nextDeadline(Never) {}
+
+    /* Returns the event slot id of the device */
+    int Register(Schedulable *handler)
+    {
+        this->events.push_back({ Never, handler, -1 });
+        return this->events.size() - 1;
+    }
+
+    void Schedule(int id, uint64_t deadline)
+    {
+        Event& event = this->events[id];
+        event.deadline = deadline;
+
+        if (event.heapIndex < 0) {
+            event.heapIndex = this->heap.size();
+            this->heap.push_back(id);
+        }
+
+        this->SiftUp(event.heapIndex);
+        this->SiftDown(event.heapIndex);
+        this->UpdateNextDeadline();
+    }
+
+    void Cancel(int id)
+    {
+        Event& event = this->events[id];
+        if (event.heapIndex < 0)
+            return;
+
+        size_t i = event.heapIndex;
+        this->Swap(i, this->heap.size() - 1);
+        this->heap.pop_back();
+        event.heapIndex = -1;
+        event.deadline = Never;
+
+        if (i < this->heap.size()) {
+            this->SiftUp(i);
+            this->SiftDown(i);
+        }
+        this->UpdateNextDeadline();
+    }
+
+    inline bool IsScheduled(int id) const
+    {
+        return this->events[id].heapIndex >= 0;
+    }
+
+    inline uint64_t GetDeadline(int id) const
+    {
+        return this->events[id].deadline;
+    }
+
+    inline uint64_t GetNextDeadline(void) const
+    {
+        return this->nextDeadline;
+    }
+
+    /* Run every event whose deadline is at or before now, in order */
+    void Dispatch(uint64_t now)
+    {
+        while (this->nextDeadline <= now) {
+            int id = this->heap[0];
+            uint64_t deadline = this->nextDeadline;
+
+            this->Cancel(id);
+            this->events[id].handler->OnEvent(deadline);
+        }
+    }
+};
+
+};
+
+#endif
@@ -0,0 +1,112 @@
+#ifndef GBEMU_SERIAL_HPP
+#define GBEMU_SERIAL_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "cpu/CPU.hpp"
+#include "cpu/InterruptController.hpp"
+#include "memory/MemoryMap.hpp"
+#include "memory/IOSegment.hpp"
+#include "Scheduler.hpp"
+#include "SerialLink.hpp"
+
+namespace GameBoy
+{
+
+/**
+ * Serial port (SB 0xFF01, SC 0xFF02)
+ *
+ * A byte takes TransferCycles with the internal 8 kHz clock. Rather than
+ * exchanging bits, the clocking end sends its byte when the transfer starts
+ * and the other end replies with its own at the next sync; both ends then
+ * complete on the same cycle. While linked, the port syncs on a scheduler
+ * event every SyncCycles, so a halted CPU still syncs on time, and the reply
+ * is always back by the second sync, before completion. Without a link, or
+ * when the other end is not waiting for a transfer, 0xFF is shifted in.
+ *
+ * In CGB mode, SC bit 1 selects the 256 kHz clock, and both clocks run twice
+ * as fast in double speed. Over a link a transfer still takes TransferCycles
+ * whatever the clock, the time the reply needs to come back.
+ *
+ * Every byte shifted out is also appended to the output, which is how most
+ * test ROMs report their results.
+ */
+class Serial : public IODevice, public Schedulable
+{
+private:
+    /* Second event slot of the port, for the link syncs */
+    class SyncEvent : public Schedulable
+    {
+    private:
+        Serial& serial;
+
+    public:
+        SyncEvent(Serial& serial) : serial(serial) {}
+
+        void OnEvent(uint64_t deadline);
+    };
+
+public:
+    static const uint16_t SBAddress = 0xFF01;
+    static const uint16_t SCAddress = 0xFF02;
+
+    static const uint64_t TransferCycles = 8 * 512;
+    static const uint64_t FastTransferCycles = 8 * 16;
+    static const uint64_t SyncCycles = TransferCycles / 2;
+
+private:
+    MemoryMap& mmap;
+    CPU& cpu;
+    InterruptController& interruptController;
+    IOSegment *segment;
+    int eventId;
+
+    bool color;
+    uint8_t sb;
+    uint8_t sc;
+
+    /* Byte shifted in when the current transfer completes */
+    uint8_t incoming;
+    uint64_t transferStart;
+
+    SerialLink *link;
+    SyncEvent syncEvent;
+    int syncEventId;
+    std::vector<SerialLink::Message> outbox;
+    std::vector<SerialLink::Message> inbox;
+
+    std::string output;
+
+    inline bool IsTransferring(void) const { return this->sc & 0x80; }
+    inline bool IsInternalClock(void) const { return this->sc & 0x01; }
+    inline bool IsFastClock(void) const { return this->sc & 0x02; }
+
+    uint64_t GetTransferCycles(void) const;
+
+    /* Exchanges messages with the other end, returns false once it is gone */
+    bool Sync(void);
+
+public:
+    Serial(MemoryMap& mmap, CPU& cpu, InterruptController& interruptController);
+    ~Serial();
+
+    /* Makes the clock speed bit of SC available */
+    inline void EnableColor(void) { this->color = true; }
+
+    /* Both ends must be linked on the same cycle, syncing every SyncCycles from then on */
+    void SetLink(SerialLink *link);
+
+    inline const std::string& GetOutput(void) const { return this->output; }
+    inline void ClearOutput(void) { this->output.clear(); }
+
+    uint8_t ReadRegister(uint16_t address);
+    void WriteRegister(uint16_t address, uint8_t byte);
+
+    void OnEvent(uint64_t deadline);
+};
+
+};
+
+#endif
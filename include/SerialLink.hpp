@@ -0,0 +1,101 @@
+#ifndef GBEMU_SERIAL_LINK_HPP
+#define GBEMU_SERIAL_LINK_HPP
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace GameBoy
+{
+
+/**
+ * One end of a link cable
+ *
+ * Ends only talk at sync points, where each one sends the batch of messages
+ * produced since the previous sync, closed by a MessageSync, and then
+ * receives the batch of the other end. Both ends must sync at the same
+ * cycles.
+ */
+class SerialLink
+{
+public:
+    enum MessageType : uint8_t {
+        /* A transfer clocked by the sender started, with the sender's byte */
+        MessageStart,
+        /* The byte of the receiver of a MessageStart */
+        MessageReply,
+        MessageSync
+    };
+
+    struct Message {
+        uint64_t cycles;
+        MessageType type;
+        uint8_t byte;
+    };
+
+    virtual ~SerialLink() {}
+
+    virtual void Send(const std::vector<Message>& messages) = 0;
+
+    /* Blocks for the batch of the other end, returns false once it is gone */
+    virtual bool Receive(std::vector<Message>& messages) = 0;
+};
+
+/* Both ends in the same process, possibly on different threads */
+class LocalSerialLink : public SerialLink
+{
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::deque<Message> messages;
+        bool closed;
+    };
+
+    std::shared_ptr<Queue> inbox;
+    std::shared_ptr<Queue> outbox;
+
+    LocalSerialLink(std::shared_ptr<Queue> inbox, std::shared_ptr<Queue> outbox)
+    : inbox(inbox), outbox(outbox)
+    {
+    }
+
+public:
+    ~LocalSerialLink();
+
+    static std::pair<std::unique_ptr<LocalSerialLink>, std::unique_ptr<LocalSerialLink>> CreatePair(void);
+
+    void Send(const std::vector<Message>& messages);
+    bool Receive(std::vector<Message>& messages);
+};
+
+/* Ends in two processes, over a Unix socket */
+class SocketSerialLink : public SerialLink
+{
+private:
+    int fd;
+
+    /* Bytes received but not consumed yet */
+    std::string input;
+
+    SocketSerialLink(int fd) : fd(fd) {}
+
+public:
+    ~SocketSerialLink();
+
+    /* Waits for the other end to connect */
+    static std::unique_ptr<SocketSerialLink> Listen(const std::string& path);
+    static std::unique_ptr<SocketSerialLink> Connect(const std::string& path);
+
+    void Send(const std::vector<Message>& messages);
+    bool Receive(std::vector<Message>& messages);
+};
+
+};
+
+#endif
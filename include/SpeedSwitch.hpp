@@ -0,0 +1,72 @@
+#ifndef GBEMU_SPEED_SWITCH_HPP
+#define GBEMU_SPEED_SWITCH_HPP
+
+#include "cpu/CPU.hpp"
+#include "memory/MemoryMap.hpp"
+#include "memory/IOSegment.hpp"
+#include "Timer.hpp"
+
+namespace GameBoy
+{
+
+/**
+ * CGB speed switch (KEY1 0xFF4D)
+ *
+ * Writing bit 0 arms the switch, and the next STOP toggles between normal
+ * and double speed instead of stopping. Double speed only halves the cycles
+ * per M-cycle of the CPU and doubles the rate of the divider and of the
+ * serial clock; the LCD and the APU keep counting the same cycles.
+ */
+class SpeedSwitch : public IODevice
+{
+public:
+    static const uint16_t KEY1Address = 0xFF4D;
+
+private:
+    MemoryMap& mmap;
+    CPU& cpu;
+    Timer& timer;
+    IOSegment *segment;
+
+    bool armed;
+
+public:
+    SpeedSwitch(MemoryMap& mmap, CPU& cpu, Timer& timer)
+    : mmap(mmap), cpu(cpu), timer(timer), armed(false)
+    {
+        this->segment = new IOSegment("KEY1", KEY1Address, KEY1Address + 1, this);
+        this->mmap.AddSegment(this->segment);
+        this->cpu.SetSpeedSwitch(this);
+    }
+
+    ~SpeedSwitch()
+    {
+        this->cpu.SetSpeedSwitch(nullptr);
+        delete this->segment;
+    }
+
+    inline bool IsArmed(void) const { return this->armed; }
+
+    /* Called by the CPU on STOP while armed */
+    void Switch(void)
+    {
+        bool doubleSpeed = !this->cpu.IsDoubleSpeed();
+        this->cpu.SetDoubleSpeed(doubleSpeed);
+        this->timer.SetDoubleSpeed(doubleSpeed);
+        this->armed = false;
+    }
+
+    uint8_t ReadRegister(uint16_t)
+    {
+        return 0x7E | (this->cpu.IsDoubleSpeed() ? 0x80 : 0) | (this->armed ? 0x01 : 0);
+    }
+
+    void WriteRegister(uint16_t, uint8_t byte)
+    {
+        this->armed = byte & 0x01;
+    }
+};
+
+};
+
+#endif
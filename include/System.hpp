@@ -0,0 +1,82 @@
+#ifndef GBEMU_SYSTEM_HPP
+#define GBEMU_SYSTEM_HPP
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "cpu/CPU.hpp"
+#include "cpu/InterruptController.hpp"
+#include "memory/MemoryBanks.hpp"
+#include "memory/MemoryMap.hpp"
+#include "audio/APU.hpp"
+#include "Video.hpp"
+#include "DMA.hpp"
+#include "Timer.hpp"
+#include "Serial.hpp"
+#include "Joypad.hpp"
+#include "WorkRAM.hpp"
+#include "HDMA.hpp"
+#include "SpeedSwitch.hpp"
+
+namespace GameBoy
+{
+
+/**
+ * The memory map, the CPU and every device, wired the same way for all the
+ * tools so that a run in one of them can be reproduced in another.
+ *
+ * The CGB-only devices (WorkRAM, HDMA, SpeedSwitch) only exist in CGB mode.
+ * Mapping the cartridge is left to the owner, MapBlob() mapping a raw blob
+ * the way LoadBlob always has.
+ */
+class System
+{
+private:
+    MemoryMap mmap;
+    CPU cpu;
+    InterruptController interruptController;
+    Video video;
+    DMA dma;
+    Timer timer;
+    Serial serial;
+    Joypad joypad;
+    std::unique_ptr<WorkRAM> wram;
+    std::unique_ptr<HDMA> hdma;
+    std::unique_ptr<SpeedSwitch> speedSwitch;
+    APU apu;
+
+    std::unique_ptr<MemorySegment> blobSegment;
+
+public:
+    /* render and audio as taken by Video and APU, headless by default */
+    System(bool color = false, bool render = false, AudioRing *audio = nullptr);
+    ~System();
+
+    inline bool IsColor(void) const { return this->wram != nullptr; }
+
+    inline MemoryMap& GetMemoryMap(void) { return this->mmap; }
+    inline CPU& GetCPU(void) { return this->cpu; }
+    inline InterruptController& GetInterruptController(void) { return this->interruptController; }
+    inline Video& GetVideo(void) { return this->video; }
+    inline DMA& GetDMA(void) { return this->dma; }
+    inline Timer& GetTimer(void) { return this->timer; }
+    inline Serial& GetSerial(void) { return this->serial; }
+    inline Joypad& GetJoypad(void) { return this->joypad; }
+    inline APU& GetAPU(void) { return this->apu; }
+
+    /* Every banked window of the address space, for hashing the switched out banks too */
+    std::vector<MemoryBanks*> GetMemoryBanks(void);
+
+    static const uint32_t BlobEnd = 0x8000;
+
+    /**
+     * Maps up to 0x8000 bytes of contents from 0x0000, writable, in front of
+     * everything mapped so far. contents must outlive the system.
+     */
+    void MapBlob(uint8_t *contents, uint32_t size);
+};
+
+};
+
+#endif
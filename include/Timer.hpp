@@ -0,0 +1,94 @@
+#ifndef GBEMU_TIMER_HPP
+#define GBEMU_TIMER_HPP
+
+#include <cstdint>
+
+#include "cpu/CPU.hpp"
+#include "cpu/InterruptController.hpp"
+#include "memory/MemoryMap.hpp"
+#include "memory/IOSegment.hpp"
+#include "Scheduler.hpp"
+
+namespace GameBoy
+{
+
+/**
+ * DIV/TIMA/TMA/TAC timer (0xFF04-0xFF07)
+ *
+ * Nothing is incremented per cycle: DIV is the upper byte of the cycles
+ * elapsed since it was last reset, and TIMA is brought up to date from the
+ * number of falling edges of the selected divider bit since the last access.
+ * The only event is the next TIMA overflow.
+ *
+ * In CGB double speed the divider counts two per cycle, following the CPU.
+ */
+class Timer : public IODevice, public Schedulable
+{
+public:
+    static const uint16_t DIVAddress  = 0xFF04;
+    static const uint16_t TIMAAddress = 0xFF05;
+    static const uint16_t TMAAddress  = 0xFF06;
+    static const uint16_t TACAddress  = 0xFF07;
+
+private:
+    MemoryMap& mmap;
+    CPU& cpu;
+    InterruptController& interruptController;
+    IOSegment *segment;
+    int eventId;
+
+    /* Cycle at which the internal divider was last reset */
+    uint64_t divBase;
+    /* Cycle at which tima was last brought up to date */
+    uint64_t timaBase;
+
+    uint8_t tima;
+    uint8_t tma;
+    uint8_t tac;
+
+    /* 1 in double speed */
+    uint8_t speedShift;
+
+    /* Internal divider at now, DIV being its upper byte */
+    inline uint64_t GetDivider(uint64_t now) const
+    {
+        return (now - this->divBase) << this->speedShift;
+    }
+
+    inline bool IsEnabled(void) const { return this->tac & 0x04; }
+
+    /* TIMA ticks on the falling edge of divider bit 9, 3, 5 or 7 */
+    inline uint8_t GetPeriodShift(void) const
+    {
+        static const uint8_t shifts[] = { 10, 4, 6, 8 };
+        return shifts[this->tac & 0x03];
+    }
+
+    inline bool IsSelectedBitSet(uint64_t now) const
+    {
+        return (this->GetDivider(now) >> (this->GetPeriodShift() - 1)) & 1;
+    }
+
+    void Increment(uint64_t n);
+    void Sync(uint64_t now);
+    void ScheduleOverflow(void);
+
+public:
+    Timer(MemoryMap& mmap, CPU& cpu, InterruptController& interruptController);
+    ~Timer();
+
+    /* Speed switches reset the divider */
+    void SetDoubleSpeed(bool doubleSpeed);
+
+    /* Sets the whole internal divider, as left by the boot ROM */
+    void SetDivider(uint16_t divider);
+
+    uint8_t ReadRegister(uint16_t address);
+    void WriteRegister(uint16_t address, uint8_t byte);
+
+    void OnEvent(uint64_t deadline);
+};
+
+};
+
+#endif
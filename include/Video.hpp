@@ -1,39 +1,245 @@
 #ifndef GBEMU_VIDEO_HPP
 #define GBEMU_VIDEO_HPP
 
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "cpu/CPU.hpp"
+#include "cpu/InterruptController.hpp"
+#include "memory/MemoryBanks.hpp"
 #include "memory/MemoryMap.hpp"
+#include "memory/IOSegment.hpp"
+#include "Scheduler.hpp"
 
 namespace GameBoy
 {
 
-class Video 
+class Video;
+
+/* Receives every composed frame, on the render thread */
+class FrameSink
+{
+public:
+    virtual ~FrameSink() {}
+
+    /* Pixels are 0xAARRGGBB, row after row */
+    virtual void OnFrame(const uint32_t *pixels, uint64_t frame) = 0;
+};
+
+/* Notified at the start of every HBlank, on the CPU thread */
+class HBlankListener
+{
+public:
+    virtual ~HBlankListener() {}
+
+    virtual void OnHBlank(uint64_t now) = 0;
+};
+
+/* VRAM or OAM, reporting writes so that the render thread can replay them */
+class VideoMemorySegment : public MemorySegment
 {
 private:
-    MemoryMap& mmap;
-    
-    uint8_t *vram;
-    MemorySegment *vramSegment;
+    Video& video;
 
 public:
-    Video(MemoryMap& mmap) : mmap(mmap)
+    VideoMemorySegment(const std::string& name, uint16_t begin, uint32_t end,
+                       uint8_t *memory, Video& video)
+    : MemorySegment(name, begin, end, Permissions::ReadWrite, memory), video(video)
     {
-        this->vram = new uint8_t [0x2000];
-        this->vramSegment = new MemorySegment(
-            "VRAM", 0x8000, 0xA000,
-            GameBoy::MemorySegment::Permissions::ReadWrite,   
-            this->vram
-        );
-
-        this->mmap.AddSegment(this->vramSegment);
     }
 
-    ~Video()
+    void Write(uint16_t address, const uint8_t *bytes, uint16_t size);
+    void WriteByte(uint16_t address, const uint8_t byte);
+};
+
+/**
+ * LCD controller and PPU (VRAM, OAM, 0xFF40-0xFF45 and 0xFF47-0xFF4B, plus
+ * 0xFF4F and 0xFF68-0xFF6B in CGB mode)
+ *
+ * LY and the STAT mode are derived from the cycles elapsed since the LCD was
+ * switched on, with a fixed 172 cycle mode 3. Events only fire at line
+ * starts and HBlank to raise interrupts.
+ *
+ * When rendering, nothing is drawn on the CPU thread: the registers are
+ * latched per line at the end of mode 3 and VRAM/OAM writes are logged with
+ * the line they precede. At VBlank the frame record goes to a render thread
+ * which replays it over its own copy of VRAM/OAM into one of two
+ * framebuffers, while the CPU emulates the next frame into the other record.
+ *
+ * In CGB mode, VBK repoints the VRAM segment to one of the two banks and the
+ * color palettes are logged along with VRAM writes. Tile attributes, sprite
+ * banks and palettes are then used by the renderer.
+ */
+class Video : public IODevice, public Schedulable
+{
+public:
+    static const int Width = 160;
+    static const int Height = 144;
+
+    static const uint64_t LineCycles = 456;
+    static const uint64_t FrameLines = 154;
+    static const uint64_t FrameCycles = LineCycles * FrameLines;
+    static const uint64_t HBlankCycle = 80 + 172;
+
+    static const uint16_t LCDCAddress = 0xFF40;
+    static const uint16_t STATAddress = 0xFF41;
+    static const uint16_t SCYAddress  = 0xFF42;
+    static const uint16_t SCXAddress  = 0xFF43;
+    static const uint16_t LYAddress   = 0xFF44;
+    static const uint16_t LYCAddress  = 0xFF45;
+    static const uint16_t BGPAddress  = 0xFF47;
+    static const uint16_t OBP0Address = 0xFF48;
+    static const uint16_t OBP1Address = 0xFF49;
+    static const uint16_t WYAddress   = 0xFF4A;
+    static const uint16_t WXAddress   = 0xFF4B;
+    static const uint16_t VBKAddress  = 0xFF4F;
+    static const uint16_t BCPSAddress = 0xFF68;
+    static const uint16_t BCPDAddress = 0xFF69;
+    static const uint16_t OCPSAddress = 0xFF6A;
+    static const uint16_t OCPDAddress = 0xFF6B;
+
+    static const uint16_t VRAMBankSize = 0x2000;
+    static const uint16_t PaletteSize = 64;
+
+private:
+    struct LineState {
+        uint8_t lcdc;
+        uint8_t scy;
+        uint8_t scx;
+        uint8_t bgp;
+        uint8_t obp0;
+        uint8_t obp1;
+        uint8_t wy;
+        uint8_t wx;
+    };
+
+    struct MemoryWrite {
+        /* VRAM bank 1 is logged at 0xA000-0xBFFF, palettes past OAM */
+        uint16_t address;
+        uint8_t byte;
+        /* Applied before rendering this line */
+        uint8_t line;
+    };
+
+    struct FrameRecord {
+        /* Set when VRAM and OAM are snapshotted instead of logged */
+        bool reload;
+        std::vector<uint8_t> vram;
+        std::vector<uint8_t> oam;
+        uint8_t bgPalettes[PaletteSize];
+        uint8_t objPalettes[PaletteSize];
+
+        LineState lines[Height];
+        int nLines;
+        std::vector<MemoryWrite> writes;
+    };
+
+    MemoryMap& mmap;
+    CPU& cpu;
+    InterruptController& interruptController;
+    int eventId;
+
+    uint8_t *vram;
+    MemoryBanks *vramBanks;
+    MemorySegment *vramSegment;
+
+    uint8_t *oam;
+    MemorySegment *oamSegment;
+
+    IOSegment *lcdSegment;
+    IOSegment *paletteSegment;
+    IOSegment *vbkSegment;
+    IOSegment *colorPaletteSegment;
+
+    LineState state;
+    uint8_t stat;
+    uint8_t lyc;
+
+    bool color;
+    uint8_t vbk;
+    uint8_t bcps;
+    uint8_t ocps;
+    uint8_t bgPalettes[PaletteSize];
+    uint8_t objPalettes[PaletteSize];
+
+    HBlankListener *hblankListener;
+
+    /* Cycle at which the LCD was last switched on */
+    uint64_t lcdStart;
+    bool hblankNext;
+
+    bool render;
+    FrameRecord records[2];
+    FrameRecord *filling;
+    FrameRecord *rendering;
+
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool closing;
+
+    /* Render thread state */
+    std::vector<uint8_t> shadowVram;
+    std::vector<uint8_t> shadowOam;
+    uint8_t shadowBgPalettes[PaletteSize];
+    uint8_t shadowObjPalettes[PaletteSize];
+    std::vector<uint32_t> framebuffers[2];
+    int back;
+    uint64_t nFrames;
+    FrameSink *sink;
+
+    inline bool IsLCDOn(void) const { return this->state.lcdc & 0x80; }
+
+    inline uint64_t GetLine(uint64_t now) const
     {
-        delete this->vramSegment;
-        delete [] this->vram;
+        return ((now - this->lcdStart) / LineCycles) % FrameLines;
     }
+
+    uint8_t GetMode(uint64_t now) const;
+    void RequestStat(uint8_t source);
+
+    void TurnOn(uint64_t now);
+    void TurnOff(void);
+    void Submit(void);
+
+    void Work(void);
+    void Compose(const FrameRecord& record);
+    uint8_t GetTilePixel(uint16_t map, uint8_t x, uint8_t y, uint8_t lcdc) const;
+    void RenderLine(const LineState& line, int y, int& windowLine, uint32_t *row) const;
+    uint8_t GetColorTilePixel(uint16_t map, uint8_t x, uint8_t y, uint8_t lcdc, uint8_t& attributes) const;
+    void RenderColorLine(const LineState& line, int y, int& windowLine, uint32_t *row) const;
+    void WritePalette(uint8_t& index, uint8_t *palettes, uint16_t logBase, uint8_t byte);
+
+public:
+    Video(MemoryMap& mmap, CPU& cpu, InterruptController& interruptController, bool render = false);
+    ~Video();
+
+    /* Called on the render thread, set before the LCD is switched on */
+    inline void SetFrameSink(FrameSink *sink) { this->sink = sink; }
+
+    /* Waits for the frame being composed, if any */
+    void Finish(void);
+
+    /* Switches to CGB mode, set before the LCD is switched on */
+    void EnableColor(void);
+
+    inline MemoryBanks& GetVRAMBanks(void) { return *this->vramBanks; }
+
+    inline void SetHBlankListener(HBlankListener *listener) { this->hblankListener = listener; }
+    /* Also true while the LCD is off */
+    inline bool IsHBlank(void) const { return this->GetMode(this->cpu.GetCycles()) == 0; }
+
+    void OnMemoryWrite(uint16_t address, uint8_t byte);
+
+    uint8_t ReadRegister(uint16_t address);
+    void WriteRegister(uint16_t address, uint8_t byte);
+
+    void OnEvent(uint64_t deadline);
 };
 
 };
 
-#endif
\ No newline at end of file
+#endif
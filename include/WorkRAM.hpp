@@ -0,0 +1,80 @@
+#ifndef GBEMU_WORK_RAM_HPP
+#define GBEMU_WORK_RAM_HPP
+
+#include <cstdint>
+
+#include "memory/MemoryBanks.hpp"
+#include "memory/MemoryMap.hpp"
+#include "memory/IOSegment.hpp"
+
+namespace GameBoy
+{
+
+/**
+ * CGB switchable WRAM banks (SVBK 0xFF70)
+ *
+ * Banks 1-7 are served at 0xD000-0xDFFF by a segment mapped over the fixed
+ * DMG one, bank 0 staying at 0xC000-0xCFFF. Switching repoints the segment
+ * and hands the pages written so far over to the bank being left.
+ */
+class WorkRAM : public IODevice
+{
+public:
+    static const uint16_t SVBKAddress = 0xFF70;
+    static const uint16_t BankBase = 0xD000;
+    static const uint16_t BankSize = 0x1000;
+    static const int Banks = 7;
+
+private:
+    MemoryMap& mmap;
+    IOSegment *segment;
+
+    uint8_t *banks;
+    MemoryBanks memoryBanks;
+    MemorySegment *bankSegment;
+    uint8_t svbk;
+
+public:
+    WorkRAM(MemoryMap& mmap)
+    : mmap(mmap), banks(new uint8_t [Banks * BankSize]()),
+      memoryBanks(mmap, banks, BankBase, BankSize, Banks), svbk(0)
+    {
+        this->bankSegment = new MemorySegment(
+            "WRAMX", BankBase, BankBase + BankSize,
+            GameBoy::MemorySegment::Permissions::ReadWrite,
+            this->banks
+        );
+        this->segment = new IOSegment("SVBK", SVBKAddress, SVBKAddress + 1, this);
+
+        this->mmap.InsertSegment(this->bankSegment);
+        this->mmap.AddSegment(this->segment);
+    }
+
+    ~WorkRAM()
+    {
+        delete this->segment;
+        delete this->bankSegment;
+        delete [] this->banks;
+    }
+
+    inline MemoryBanks& GetMemoryBanks(void) { return this->memoryBanks; }
+
+    uint8_t ReadRegister(uint16_t)
+    {
+        return 0xF8 | this->svbk;
+    }
+
+    void WriteRegister(uint16_t, uint8_t byte)
+    {
+        this->svbk = byte & 0x07;
+
+        /* Bank 0 selects bank 1 */
+        int bank = this->svbk ? this->svbk : 1;
+        this->bankSegment->SetMemory(this->banks + (bank - 1) * BankSize);
+        this->memoryBanks.Switch(bank - 1);
+    }
+};
+
+};
+
+#endif
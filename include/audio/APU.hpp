@@ -0,0 +1,202 @@
+#ifndef GBEMU_APU_HPP
+#define GBEMU_APU_HPP
+
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "audio/BlipBuffer.hpp"
+#include "audio/RingBuffer.hpp"
+#include "cpu/CPU.hpp"
+#include "memory/MemoryMap.hpp"
+#include "memory/IOSegment.hpp"
+#include "Scheduler.hpp"
+
+namespace GameBoy
+{
+
+struct StereoSample {
+    int16_t left;
+    int16_t right;
+};
+
+typedef RingBuffer<StereoSample> AudioRing;
+
+/**
+ * Four channel APU state machine, driven by timestamps only
+ *
+ * Channels are only brought up to date when a register is written or Run()
+ * is called. The 512 Hz frame sequencer steps are applied on the way, and
+ * each one also closes a buffer frame. Between two of those points each
+ * channel walks its waveform edge by edge and only reports actual amplitude
+ * changes to the band-limited buffers. Without an output ring the registers
+ * still behave but nothing is synthesized.
+ *
+ * The output only depends on the sequence of timestamped writes, not on when
+ * Run() is called, which is what lets the APU replay writes on another thread.
+ */
+class APUCore
+{
+public:
+    static const uint16_t NR10Address = 0xFF10;
+    static const uint16_t NR50Address = 0xFF24;
+    static const uint16_t NR51Address = 0xFF25;
+    static const uint16_t NR52Address = 0xFF26;
+    static const uint16_t WaveRAMAddress = 0xFF30;
+    static const uint32_t EndAddress = 0xFF40;
+
+    static const uint32_t ClockRate = 4194304;
+    static const uint32_t DefaultSampleRate = 48000;
+    /* Frame sequencer period */
+    static const uint64_t SequencerCycles = 8192;
+
+private:
+    /* Per channel step, all four mixed at the maximum stay within 16 bits */
+    static const int AmplitudeScale = 32;
+
+    struct Channel {
+        bool enabled;
+        bool dacEnabled;
+        bool lengthEnabled;
+        uint16_t length;
+        uint8_t volume;
+        uint8_t envelopeTimer;
+
+        /* Cycles per waveform step, 0 when the channel is never clocked */
+        uint32_t period;
+        uint64_t nextEdge;
+        /* Duty or wave RAM position */
+        uint8_t position;
+        uint16_t lfsr;
+
+        /* Last amplitudes sent to the left and right buffers */
+        int32_t amplitude[2];
+    };
+
+    AudioRing *output;
+    BlipBuffer buffers[2];
+    std::vector<int16_t> scratch[2];
+    std::vector<StereoSample> samples;
+
+    uint8_t registers[EndAddress - NR10Address];
+    bool powered;
+    uint8_t sequencerStep;
+
+    Channel channels[4];
+    uint8_t sweepTimer;
+    uint16_t sweepShadow;
+    bool sweepEnabled;
+
+    /* Cycle up to which channels were run, start of the buffer frame and next sequencer step */
+    uint64_t lastSync;
+    uint64_t frameStart;
+    uint64_t nextStep;
+
+    inline uint8_t& GetRegister(uint16_t address)
+    {
+        return this->registers[address - NR10Address];
+    }
+
+    /* NRx0-NRx4 of channel n */
+    inline uint8_t& GetChannelRegister(int n, int r)
+    {
+        return this->registers[n * 5 + r];
+    }
+
+    uint16_t GetFrequency(int n);
+    void UpdatePeriod(int n);
+    uint8_t GetLevel(int n);
+    void UpdateAmplitude(int n, uint64_t time);
+    void UpdateAmplitudes(uint64_t time);
+    void StepWaveform(int n);
+    void RunChannel(int n, uint64_t now);
+    void Sync(uint64_t now);
+
+    void Trigger(int n, uint64_t now);
+    uint16_t CalculateSweep(void);
+    void ClockLength(void);
+    void ClockSweep(void);
+    void ClockEnvelope(void);
+    void StepSequencer(void);
+    void PowerOff(void);
+    void Flush(void);
+
+public:
+    APUCore(AudioRing *output, uint32_t sampleRate, uint64_t now);
+
+    /* Brings everything up to now, flushing each completed buffer frame */
+    void Run(uint64_t now);
+
+    /* Register access at the time of the last Run() or Write() */
+    uint8_t Read(uint16_t address);
+    void Write(uint64_t now, uint16_t address, uint8_t byte);
+};
+
+/**
+ * APU registers (NR10-NR52 at 0xFF10-0xFF26, wave RAM at 0xFF30-0xFF3F)
+ *
+ * Without output, the core is only run lazily when registers are accessed.
+ * Inline synthesis runs the core from a sequencer period event. Threaded
+ * synthesis keeps a silent core for the CPU to read back, and queues every
+ * write with its cycle stamp for a second core on the audio thread. A sync
+ * marker is queued every frame: the audio thread never runs past the last
+ * marker, and the CPU only waits when the queue is full.
+ */
+class APU : public IODevice, public Schedulable
+{
+public:
+    enum SynthesisMode {
+        SynthesisInline,
+        SynthesisThreaded
+    };
+
+    static const uint64_t FrameCycles = 70224;
+
+private:
+    enum EntryType : uint8_t {
+        EntryWrite,
+        EntrySync,
+        EntryStop
+    };
+
+    struct Entry {
+        uint64_t cycles;
+        uint16_t address;
+        uint8_t byte;
+        EntryType type;
+    };
+
+    MemoryMap& mmap;
+    CPU& cpu;
+    IOSegment *segment;
+    int eventId;
+
+    SynthesisMode mode;
+    APUCore core;
+
+    std::unique_ptr<APUCore> audioCore;
+    RingBuffer<Entry> queue;
+    std::thread worker;
+
+    void Push(const Entry& entry);
+    void Work(void);
+
+public:
+    APU(MemoryMap& mmap, CPU& cpu, AudioRing *output = nullptr,
+        SynthesisMode mode = SynthesisThreaded,
+        uint32_t sampleRate = APUCore::DefaultSampleRate);
+    ~APU();
+
+    /* Synthesizes everything written so far and stops the audio thread */
+    void Finish(void);
+
+    uint8_t ReadRegister(uint16_t address);
+    void WriteRegister(uint16_t address, uint8_t byte);
+
+    void OnEvent(uint64_t deadline);
+};
+
+};
+
+#endif
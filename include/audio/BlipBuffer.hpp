@@ -0,0 +1,79 @@
+#ifndef GBEMU_BLIP_BUFFER_HPP
+#define GBEMU_BLIP_BUFFER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace GameBoy
+{
+
+/**
+ * Band-limited step synthesis, after blargg's blip_buf
+ *
+ * Instead of sampling the waveform every clock, the owner only reports the
+ * amplitude changes with AddDelta(). Each change is spread over a few output
+ * samples with a windowed sinc impulse picked by its sub-sample phase; reading
+ * integrates the buffer back into a band-limited, high-passed waveform.
+ */
+class BlipBuffer
+{
+public:
+    static const int PhaseBits = 5;
+    static const int Phases = 1 << PhaseBits;
+    static const int KernelSize = 16;
+    /* Fixed point precision of the kernel and the integrator */
+    static const int DeltaBits = 15;
+    /* High-pass strength, roughly 15 Hz at 48 kHz */
+    static const int BassShift = 9;
+
+private:
+    static const int TimeBits = 32;
+
+    int16_t kernel[Phases][KernelSize];
+
+    /* Output samples per clock, fixed point */
+    uint64_t factor;
+    /* Time of the start of the current frame relative to the buffer */
+    uint64_t offset;
+
+    std::vector<int32_t> buffer;
+    int32_t integrator;
+
+public:
+    BlipBuffer(uint32_t clockRate, uint32_t sampleRate, size_t capacity);
+
+    /* Amplitude change at a clock relative to the start of the current frame */
+    inline void AddDelta(uint32_t clock, int32_t delta)
+    {
+        uint64_t time = clock * this->factor + this->offset;
+        size_t position = time >> TimeBits;
+        const int16_t *impulse = this->kernel[(time >> (TimeBits - PhaseBits)) & (Phases - 1)];
+
+        /* Dropped rather than overflowing when nobody reads the samples */
+        if (position + KernelSize > this->buffer.size())
+            return;
+
+        int32_t *out = &this->buffer[position];
+        for (int i = 0; i < KernelSize; i++)
+            out[i] += impulse[i] * delta;
+    }
+
+    /* Makes the samples up to that clock available and starts a new frame there */
+    inline void EndFrame(uint32_t clocks)
+    {
+        this->offset += clocks * this->factor;
+    }
+
+    inline size_t GetSamplesAvailable(void) const
+    {
+        return this->offset >> TimeBits;
+    }
+
+    /* Returns the number of samples actually read */
+    size_t ReadSamples(int16_t *samples, size_t count);
+};
+
+};
+
+#endif
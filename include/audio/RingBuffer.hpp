@@ -0,0 +1,84 @@
+#ifndef GBEMU_RING_BUFFER_HPP
+#define GBEMU_RING_BUFFER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace GameBoy
+{
+
+/**
+ * Lock-free single producer, single consumer ring buffer
+ *
+ * Capacity is rounded up to a power of two. Head and tail are free running
+ * counters, each written by one side only and kept on their own cache line.
+ * A consumer that goes away closes the ring, so that a producer waiting for
+ * room knows to give up.
+ */
+template <typename T>
+class RingBuffer
+{
+private:
+    std::vector<T> items;
+    size_t mask;
+
+    alignas(64) std::atomic<size_t> head;
+    alignas(64) std::atomic<size_t> tail;
+    std::atomic<bool> closed;
+
+public:
+    RingBuffer(size_t capacity) : head(0), tail(0), closed(false)
+    {
+        size_t size = 1;
+        while (size < capacity)
+            size <<= 1;
+
+        this->items.resize(size);
+        this->mask = size - 1;
+    }
+
+    inline size_t GetCapacity(void) const { return this->items.size(); }
+
+    /* Consumer side, nothing is read anymore */
+    inline void Close(void) { this->closed.store(true, std::memory_order_release); }
+    inline bool IsClosed(void) const { return this->closed.load(std::memory_order_acquire); }
+
+    inline size_t GetSize(void) const
+    {
+        return this->head.load(std::memory_order_acquire) - this->tail.load(std::memory_order_acquire);
+    }
+
+    /* Producer side, returns the number of items actually written */
+    size_t Write(const T *items, size_t count)
+    {
+        size_t head = this->head.load(std::memory_order_relaxed);
+        size_t tail = this->tail.load(std::memory_order_acquire);
+        count = std::min(count, this->items.size() - (head - tail));
+
+        for (size_t i = 0; i < count; i++)
+            this->items[(head + i) & this->mask] = items[i];
+
+        this->head.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    /* Consumer side, returns the number of items actually read */
+    size_t Read(T *items, size_t count)
+    {
+        size_t tail = this->tail.load(std::memory_order_relaxed);
+        size_t head = this->head.load(std::memory_order_acquire);
+        count = std::min(count, head - tail);
+
+        for (size_t i = 0; i < count; i++)
+            items[i] = this->items[(tail + i) & this->mask];
+
+        this->tail.store(tail + count, std::memory_order_release);
+        return count;
+    }
+};
+
+};
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef GBEMU_WAVE_WRITER_HPP
+#define GBEMU_WAVE_WRITER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+#include "audio/APU.hpp"
+
+namespace GameBoy
+{
+
+/**
+ * Drains an audio ring into a 16-bit stereo WAV file from its own thread.
+ * The RIFF sizes are filled in by Close().
+ */
+class WaveWriter
+{
+private:
+    FILE *file;
+    AudioRing& ring;
+    uint32_t sampleRate;
+    uint64_t nSamples;
+
+    std::thread worker;
+    std::atomic<bool> closing;
+
+    void WriteHeader(void);
+    void Work(void);
+
+public:
+    WaveWriter(const std::string& path, AudioRing& ring, uint32_t sampleRate = APUCore::DefaultSampleRate);
+    ~WaveWriter();
+
+    /* Writes what is left in the ring, waits for the writer thread and closes the ring */
+    void Close(void);
+};
+
+};
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef GBEMU_CPU_HPP
-#define GBEMU_CPP_HPP
+#define GBEMU_CPU_HPP
 
+#include <algorithm>
 #include <cstdint>
 #include <iostream>
 #include <iomanip>
@@ -8,11 +9,17 @@
 
 #include "cpu/Registers.hpp"
 #include "cpu/Instruction.hpp"
+#include "cpu/InterruptController.hpp"
+#include "cpu/Profiler.hpp"
 #include "memory/MemoryMap.hpp"
+#include "Scheduler.hpp"
 
 namespace GameBoy 
 {
 
+class Debugger;
+class SpeedSwitch;
+
 class CPU
 {
 public:
@@ -35,32 +42,77 @@ private:
     bool interrupts;
     uint64_t cycles;
 
+    /* Cycles per M-cycle, halved by the CGB double speed mode */
+    uint64_t mcycle;
+    SpeedSwitch *speedSwitch;
+
+    /* Interrupts are not serviced right after EI */
+    bool interruptShadow;
+    /* HALT with IME=0 and a pending interrupt: next opcode is read twice */
+    bool haltBug;
+
+    InterruptController *interruptController;
+    Scheduler scheduler;
+
+    /* Until this cycle, only HRAM is reachable (OAM DMA in progress) */
+    uint64_t busLockedUntil;
+
+#ifdef GBEMU_PROFILE
+    Profiler *profiler;
+#endif
+
+    Debugger *debugger;
+
     MemoryInterface& mmap;
+    /* What the CPU's own accesses go through, mmap unless something watches them */
+    MemoryInterface *bus;
     Registers registers;
 
+    inline bool IsBusLocked(uint16_t address) const
+    {
+        return this->cycles < this->busLockedUntil
+            && (address < 0xFF80 || address == 0xFFFF);
+    }
+
     /* Wrapper for memory functions to count cycles */
     inline uint8_t LoadByteCycled(uint16_t address)
     {
-        this->cycles += 4;
-        return this->mmap.LoadByte(address);
+        this->cycles += this->mcycle;
+        if (this->IsBusLocked(address))
+            return 0xFF;
+        return this->bus->LoadByte(address);
     }
 
     inline void WriteByteCycled(uint16_t address, uint8_t byte)
     {
-        this->cycles += 4;
-        return this->mmap.WriteByte(address, byte);
+        this->cycles += this->mcycle;
+        if (this->IsBusLocked(address))
+            return;
+        return this->bus->WriteByte(address, byte);
     }
 
-    inline uint8_t LoadHalfWordCycled(uint16_t address)
+    inline uint16_t LoadHalfWordCycled(uint16_t address)
     {
-        this->cycles += 8;
-        return this->mmap.LoadHalfWord(address);
+        if (this->cycles < this->busLockedUntil) {
+            uint8_t lo = this->LoadByteCycled(address);
+            uint8_t hi = this->LoadByteCycled(address + 1);
+            return (hi << 8) | lo;
+        }
+
+        this->cycles += 2 * this->mcycle;
+        return this->bus->LoadHalfWord(address);
     }
 
     inline void WriteHalfWordCycled(uint16_t address, uint16_t hw)
     {
-        this->cycles += 8;
-        this->mmap.WriteHalfWord(address, hw);
+        if (this->cycles < this->busLockedUntil) {
+            this->WriteByteCycled(address, hw & 0xff);
+            this->WriteByteCycled(address + 1, hw >> 8);
+            return;
+        }
+
+        this->cycles += 2 * this->mcycle;
+        this->bus->WriteHalfWord(address, hw);
     }
 
     /* Helper functions to manipulate PC */
@@ -78,10 +130,16 @@ private:
 
     inline void SetPCCycled(uint16_t pc)
     {
-        this->cycles += 4;
+        this->cycles += this->mcycle;
         this->registers.pc = pc;
     }
 
+    /* M-cycle spent inside the CPU, without a memory access */
+    inline void InternalDelay(void)
+    {
+        this->cycles += this->mcycle;
+    }
+
     /* Arithmetic & logic implementations */
     void AAdd(uint8_t value, bool carry);
     void ASub(uint8_t value, bool carry);
@@ -226,12 +284,18 @@ private:
         return "";
     }
 
+    void ServiceInterrupt(void);
+    void Execute(void);
+    void Idle(uint64_t limit);
+    uint64_t RunDebug(uint64_t budget);
+
     Instruction DecodeNextInstruction() const;
 
 public:
     CPU(MemoryInterface& gbMMap);
     void Reset(void);
     uint64_t Step(void);
+    uint64_t Run(uint64_t budget);
 
     inline uint16_t GetPC(void) const
     {
@@ -263,20 +327,100 @@ public:
         this->interrupts = b;
     }
 
+    inline void SetInterruptController(InterruptController *interruptController)
+    {
+        this->interruptController = interruptController;
+    }
+
     inline void SetStatus(enum Status status)
     {
         this->status = status;
     }
 
+    inline uint64_t GetCycles(void) const
+    {
+        return this->cycles;
+    }
+
+    inline Scheduler& GetScheduler(void)
+    {
+        return this->scheduler;
+    }
+
+    inline bool HasPendingInterrupt(void) const
+    {
+        return this->interruptController && this->interruptController->GetPending();
+    }
+
+    /* Whether the next Step() executes an instruction, rather than servicing an interrupt or idling */
+    inline bool WillExecuteInstruction(void) const
+    {
+        bool pending = this->HasPendingInterrupt();
+        if (pending && this->interrupts && !this->interruptShadow)
+            return false;
+        return this->status == StatusRunning || (this->status == StatusHalted && pending);
+    }
+
+#ifdef GBEMU_PROFILE
+    inline void SetProfiler(Profiler *profiler)
+    {
+        this->profiler = profiler;
+    }
+#endif
+
+    inline void SetDebugger(Debugger *debugger)
+    {
+        this->debugger = debugger;
+    }
+
+    /* Routes the CPU's own accesses through bus, or straight to memory again with nullptr */
+    inline void SetBus(MemoryInterface *bus)
+    {
+        this->bus = bus ? bus : &this->mmap;
+    }
+
+    /* Restrict the CPU to HRAM for the next n cycles */
+    inline void LockBus(uint64_t n)
+    {
+        this->busLockedUntil = this->cycles + n;
+    }
+
+    /* Halt the CPU for n cycles, for transfers that take the bus entirely */
+    inline void Stall(uint64_t n)
+    {
+        this->cycles += n;
+    }
+
+    /* STOP switches speed instead of stopping while the switch is armed */
+    inline void SetSpeedSwitch(SpeedSwitch *speedSwitch)
+    {
+        this->speedSwitch = speedSwitch;
+    }
+
+    /* Only changes how many cycles an M-cycle takes, devices keep their rate */
+    inline void SetDoubleSpeed(bool doubleSpeed)
+    {
+        this->mcycle = doubleSpeed ? 2 : 4;
+    }
+
+    inline bool IsDoubleSpeed(void) const
+    {
+        return this->mcycle == 2;
+    }
+
     void Dump(void) const {
-        /* FIXME: lots of copies :( */
         Instruction instr = this->DecodeNextInstruction();
+        uint8_t bytecode[Instruction::MaxLength];
+        char text[Instruction::MaxStringLength];
+
+        uint8_t length = instr.GetBytecode(bytecode);
+        instr.Disassemble(text, sizeof(text));
+
         printf("%04X: ", this->GetPC());
-        std::vector<uint8_t> bytecode = instr.GetBytecode();
-        for (uint8_t byte : bytecode) {
-            printf("%02X ", byte);
+        for (uint8_t i = 0; i < length; i++) {
+            printf("%02X ", bytecode[i]);
         }
-        printf("\t%s\n", instr.GetString().c_str());
+        printf("\t%s\n", text);
 
         this->registers.Dump();
         printf("CYCLES: %ld\n\n", this->cycles);
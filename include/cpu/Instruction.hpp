@@ -1,9 +1,9 @@
 #ifndef GBEMU_INSTRUCTION_HPP
 #define GBEMU_INSTRUCTION_HPP
 
+#include <cstddef>
+#include <cstdint>
 #include <cstring>
-#include <string>
-#include <vector>
 
 namespace GameBoy
 {
@@ -14,26 +14,98 @@ typedef enum {
     Immediate16,
 } ImmediateType;
 
+/* Masks matching the bits of the F register */
+enum Flags : uint8_t {
+    FlagNone    = 0x00,
+    FlagC       = 0x10,
+    FlagH       = 0x20,
+    FlagN       = 0x40,
+    FlagZ       = 0x80,
+};
+
+/* How an instruction changes the control flow */
+enum BranchKind : uint8_t {
+    BranchNone,
+    BranchJump,
+    BranchJumpConditional,
+    BranchJumpRelative,
+    BranchJumpRelativeConditional,
+    BranchJumpIndirect,
+    BranchCall,
+    BranchCallConditional,
+    BranchReturn,
+    BranchReturnConditional,
+    BranchReturnInterrupt,
+    BranchRestart,
+    BranchHalt,         /* HALT and STOP */
+    BranchIllegal,
+};
+
 class AbstractInstruction
 {
 private:
-    std::string format;
-    const ImmediateType argType;
+    const char *format;
+    ImmediateType argType;
+
+    /* Length in bytes and T-cycles, including the CB prefix */
+    uint8_t length;
+    uint8_t cycles;
+    /* Cycles when a conditional branch is taken, same as cycles otherwise */
+    uint8_t cyclesTaken;
+
+    uint8_t flagsRead;
+    uint8_t flagsWritten;
+    BranchKind branch;
 
 public:
-    AbstractInstruction() : format(""), argType(NoImmediate) {}
-    AbstractInstruction(const std::string& format, const ImmediateType argType) 
-    : format(format), argType(argType) {}
+    constexpr AbstractInstruction()
+    : format(""), argType(NoImmediate), length(1), cycles(4), cyclesTaken(4),
+      flagsRead(FlagNone), flagsWritten(FlagNone), branch(BranchNone) {}
+
+    constexpr AbstractInstruction(
+        const char *format, ImmediateType argType,
+        uint8_t length, uint8_t cycles, uint8_t cyclesTaken,
+        uint8_t flagsRead, uint8_t flagsWritten, BranchKind branch)
+    : format(format), argType(argType), length(length), cycles(cycles),
+      cyclesTaken(cyclesTaken), flagsRead(flagsRead), flagsWritten(flagsWritten),
+      branch(branch) {}
+
+    constexpr const char *GetFormat() const             { return this->format; }
+    constexpr ImmediateType GetArgumentType() const     { return this->argType; }
+    constexpr uint8_t GetLength() const                 { return this->length; }
+    constexpr uint8_t GetCycles() const                 { return this->cycles; }
+    constexpr uint8_t GetCyclesTaken() const            { return this->cyclesTaken; }
+    constexpr uint8_t GetFlagsRead() const              { return this->flagsRead; }
+    constexpr uint8_t GetFlagsWritten() const           { return this->flagsWritten; }
+    constexpr BranchKind GetBranchKind() const          { return this->branch; }
+
+    constexpr bool IsConditional() const
+    {
+        return this->branch == BranchJumpConditional
+            || this->branch == BranchJumpRelativeConditional
+            || this->branch == BranchCallConditional
+            || this->branch == BranchReturnConditional;
+    }
 
-    inline const std::string& GetFormat() const         { return this->format; }
-    inline ImmediateType GetArgumentType() const        { return this->argType; }
+    /* Whether execution may not continue with the next instruction */
+    constexpr bool EndsBlock() const
+    {
+        return this->branch != BranchNone;
+    }
 };
 
-extern const AbstractInstruction InstructionTable[];
-extern const AbstractInstruction InstructionTableCB[];
+/* Both tables are constant-initialized, see InstructionSet.cpp */
+extern const AbstractInstruction InstructionTable[256];
+extern const AbstractInstruction InstructionTableCB[256];
 
 class Instruction
 {
+public:
+    /* Longest bytecode (CB prefix or 16-bit immediate) */
+    static const size_t MaxLength = 3;
+    /* Buffer size always enough for Disassemble() */
+    static const size_t MaxStringLength = 32;
+
 private:
     uint8_t opcode;
     const AbstractInstruction *baseInstruction;
@@ -54,8 +126,16 @@ public:
 
     ~Instruction() { this->baseInstruction = nullptr; }
 
-    std::vector<uint8_t> GetBytecode() const;
-    std::string GetString() const;
+    /* Decode from raw bytecode, at least MaxLength bytes must be readable */
+    static Instruction Decode(const uint8_t *bytes);
+
+    uint8_t GetLength() const;
+
+    /* Writes GetLength() bytes to bytes, returns the length */
+    uint8_t GetBytecode(uint8_t *bytes) const;
+
+    /* Writes the mnemonic to buffer, always NUL-terminated, returns its length */
+    size_t Disassemble(char *buffer, size_t size) const;
 
     /* TODO: make Instruction inherit AbstractInstruction */
     const AbstractInstruction *GetBaseInstruction() { return this->baseInstruction; }
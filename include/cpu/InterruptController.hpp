@@ -0,0 +1,101 @@
+#ifndef GBEMU_INTERRUPT_CONTROLLER_HPP
+#define GBEMU_INTERRUPT_CONTROLLER_HPP
+
+#include <cstdint>
+
+#include "memory/MemoryMap.hpp"
+#include "memory/IOSegment.hpp"
+
+namespace GameBoy
+{
+
+/* IF (0xFF0F) and IE (0xFFFF) registers */
+class InterruptController : public IODevice
+{
+public:
+    /* Bit positions in IF/IE, also the priority order */
+    enum Interrupt {
+        InterruptVBlank     = 0,
+        InterruptLCDStat    = 1,
+        InterruptTimer      = 2,
+        InterruptSerial     = 3,
+        InterruptJoypad     = 4
+    };
+
+    static const uint16_t FlagAddress = 0xFF0F;
+    static const uint16_t EnableAddress = 0xFFFF;
+
+private:
+    MemoryMap& mmap;
+    IOSegment *flagSegment;
+    IOSegment *enableSegment;
+
+    uint8_t flags;
+    uint8_t enable;
+
+public:
+    InterruptController(MemoryMap& mmap) : mmap(mmap), flags(0), enable(0)
+    {
+        this->flagSegment = new IOSegment("IF", FlagAddress, FlagAddress + 1, this);
+        this->enableSegment = new IOSegment("IE", EnableAddress, EnableAddress + 1, this);
+
+        this->mmap.AddSegment(this->flagSegment);
+        this->mmap.AddSegment(this->enableSegment);
+    }
+
+    ~InterruptController()
+    {
+        delete this->enableSegment;
+        delete this->flagSegment;
+    }
+
+    inline void Request(enum Interrupt i)
+    {
+        this->flags |= (1 << i);
+    }
+
+    inline void Acknowledge(enum Interrupt i)
+    {
+        this->flags &= ~(1 << i);
+    }
+
+    /* Interrupts both requested and enabled */
+    inline uint8_t GetPending(void) const
+    {
+        return this->flags & this->enable & 0x1f;
+    }
+
+    /* Highest priority pending interrupt, GetPending() must be non-zero */
+    inline enum Interrupt GetHighestPriority(void) const
+    {
+        uint8_t pending = this->GetPending();
+        uint8_t i = 0;
+        while (!(pending & (1 << i)))
+            i++;
+        return (enum Interrupt) i;
+    }
+
+    static inline uint16_t GetVector(enum Interrupt i)
+    {
+        return 0x40 + i * 8;
+    }
+
+    uint8_t ReadRegister(uint16_t address)
+    {
+        if (address == FlagAddress)
+            return this->flags | 0xe0;
+        return this->enable;
+    }
+
+    void WriteRegister(uint16_t address, uint8_t byte)
+    {
+        if (address == FlagAddress)
+            this->flags = byte & 0x1f;
+        else
+            this->enable = byte;
+    }
+};
+
+};
+
+#endif
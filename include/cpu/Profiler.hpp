@@ -0,0 +1,68 @@
+#ifndef GBEMU_PROFILER_HPP
+#define GBEMU_PROFILER_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "memory/MemoryMap.hpp"
+
+namespace GameBoy
+{
+
+/**
+ * Execution counters per opcode and per PC
+ *
+ * The CPU only feeds a profiler when built with GBEMU_PROFILE (make
+ * PROFILE=1), otherwise the hook is compiled out. Saved profiles keep the
+ * bytecode found at each PC so that ProfileDump can disassemble them.
+ */
+class Profiler
+{
+public:
+    struct Counter {
+        uint64_t executions;
+        uint64_t cycles;
+    };
+
+    struct AddressEntry {
+        uint16_t pc;
+        uint8_t bytecode[3];
+        Counter counter;
+    };
+
+private:
+    Counter opcodes[256];
+    Counter opcodesCB[256];
+    Counter addresses[0x10000];
+
+public:
+    Profiler() { this->Reset(); }
+
+    void Reset(void);
+
+    /* opcode is the CB page opcode when prefix is 0xCB */
+    inline void Record(uint16_t pc, uint8_t prefix, uint8_t opcode, uint64_t cycles)
+    {
+        Counter& counter = (prefix == 0xCB) ? this->opcodesCB[opcode] : this->opcodes[prefix];
+        counter.executions++;
+        counter.cycles += cycles;
+
+        this->addresses[pc].executions++;
+        this->addresses[pc].cycles += cycles;
+    }
+
+    inline const Counter& GetOpcode(uint8_t opcode) const   { return this->opcodes[opcode]; }
+    inline const Counter& GetOpcodeCB(uint8_t opcode) const { return this->opcodesCB[opcode]; }
+    inline const Counter& GetAddress(uint16_t pc) const     { return this->addresses[pc]; }
+
+    /* Writes the counters, with the bytecode currently mapped at each PC hit */
+    void Save(const std::string& path, const MemoryMap& mmap) const;
+
+    /* Reads a saved profile, returns the PCs that were hit */
+    std::vector<AddressEntry> Load(const std::string& path);
+};
+
+};
+
+#endif
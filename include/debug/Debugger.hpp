@@ -0,0 +1,229 @@
+#ifndef GBEMU_DEBUGGER_HPP
+#define GBEMU_DEBUGGER_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "cpu/CPU.hpp"
+#include "memory/MemoryInterface.hpp"
+#include "memory/MemoryMap.hpp"
+#include "memory/MemorySegment.hpp"
+
+namespace GameBoy
+{
+
+class Debugger;
+
+/**
+ * Segment mapped over a watched range, reporting every matching access of the
+ * CPU to the debugger before forwarding it to the segment it hides. DMA and
+ * front-ends reading memory go through unreported.
+ */
+class Watchpoint : public MemorySegment
+{
+public:
+    enum Type {
+        WatchRead   = 1,
+        WatchWrite  = 2,
+        WatchAccess = 3,
+    };
+
+private:
+    MemoryMap& mmap;
+    Debugger& debugger;
+    Type type;
+
+    inline MemorySegment *GetBelow(uint16_t address) const
+    {
+        return this->mmap.GetSegmentBelow(this, address);
+    }
+
+public:
+    Watchpoint(MemoryMap& mmap, Debugger& debugger, uint16_t begin, uint32_t end, Type type)
+    : MemorySegment("WATCH", begin, end, Permissions::ReadWrite, nullptr),
+      mmap(mmap), debugger(debugger), type(type)
+    {
+    }
+
+    inline Type GetType(void) const { return this->type; }
+
+    uint8_t LoadByte(uint16_t address) const;
+    void WriteByte(uint16_t address, const uint8_t byte);
+
+    void Load(uint16_t address, uint8_t *bytes, uint16_t size) const
+    {
+        for (uint16_t i = 0; i < size; i++)
+            bytes[i] = this->LoadByte(address + i);
+    }
+
+    void Write(uint16_t address, const uint8_t *bytes, uint16_t size)
+    {
+        for (uint16_t i = 0; i < size; i++)
+            this->WriteByte(address + i, bytes[i]);
+    }
+};
+
+/**
+ * Memory the CPU goes through while watchpoints are set, noting the access in
+ * progress so that watchpoints can tell the CPU's own accesses from DMA and
+ * front-ends reading memory, without any cost once none are set.
+ */
+class WatchedBus : public MemoryInterface
+{
+private:
+    MemoryMap& mmap;
+
+    mutable uint16_t address;
+    mutable uint16_t size;
+    mutable bool write;
+
+    inline void Begin(uint16_t address, uint16_t size, bool write) const
+    {
+        this->address = address;
+        this->size = size;
+        this->write = write;
+    }
+
+public:
+    WatchedBus(MemoryMap& mmap) : mmap(mmap), address(0), size(0), write(false) {}
+
+    /* Whether the CPU is reading or writing address right now */
+    inline bool IsAccessing(uint16_t address, bool write) const
+    {
+        return static_cast<uint16_t>(address - this->address) < this->size && this->write == write;
+    }
+
+    void Load(uint16_t address, uint8_t *bytes, uint16_t size) const
+    {
+        this->Begin(address, size, false);
+        this->mmap.Load(address, bytes, size);
+        this->size = 0;
+    }
+
+    uint8_t LoadByte(uint16_t address) const
+    {
+        this->Begin(address, 1, false);
+        uint8_t byte = this->mmap.LoadByte(address);
+        this->size = 0;
+        return byte;
+    }
+
+    uint16_t LoadHalfWord(uint16_t address) const
+    {
+        this->Begin(address, 2, false);
+        uint16_t halfword = this->mmap.LoadHalfWord(address);
+        this->size = 0;
+        return halfword;
+    }
+
+    void Write(uint16_t address, const uint8_t *bytes, uint16_t size)
+    {
+        this->Begin(address, size, true);
+        this->mmap.Write(address, bytes, size);
+        this->size = 0;
+    }
+
+    void WriteByte(uint16_t address, const uint8_t byte)
+    {
+        this->Begin(address, 1, true);
+        this->mmap.WriteByte(address, byte);
+        this->size = 0;
+    }
+
+    void WriteHalfWord(uint16_t address, uint16_t halfword)
+    {
+        this->Begin(address, 2, true);
+        this->mmap.WriteHalfWord(address, halfword);
+        this->size = 0;
+    }
+};
+
+/**
+ * Debugger core
+ *
+ * PC breakpoints live in a bitmap covering the address space. Watchpoints
+ * are segments inserted in front of the memory map, so nothing is checked
+ * on unwatched accesses, and the CPU only goes through a WatchedBus while
+ * some are set. CPU::Run() only switches to its checking loop while at least
+ * one breakpoint or watchpoint is set.
+ */
+class Debugger
+{
+public:
+    enum StopReason {
+        StopNone,
+        StopBreakpoint,
+        StopWatchpoint,
+    };
+
+    struct WatchHit {
+        uint16_t address;
+        /* Access that hit, and type of the watchpoint it hit */
+        Watchpoint::Type type;
+        Watchpoint::Type watched;
+        uint8_t value;
+    };
+
+private:
+    MemoryMap& mmap;
+    CPU& cpu;
+
+    uint64_t breakpoints[0x10000 / 64];
+    size_t nBreakpoints;
+
+    std::vector<Watchpoint*> watchpoints;
+    WatchedBus bus;
+
+    StopReason stopReason;
+    uint16_t stopPC;
+    WatchHit watchHit;
+
+public:
+    Debugger(MemoryMap& mmap, CPU& cpu);
+    ~Debugger();
+
+    inline bool IsActive(void) const
+    {
+        return this->nBreakpoints || !this->watchpoints.empty();
+    }
+
+    inline bool HasBreakpoint(uint16_t pc) const
+    {
+        return this->breakpoints[pc >> 6] & (1ULL << (pc & 63));
+    }
+
+    void AddBreakpoint(uint16_t pc);
+    void RemoveBreakpoint(uint16_t pc);
+
+    /* Watches [begin, end) */
+    void AddWatchpoint(uint16_t begin, uint32_t end, Watchpoint::Type type);
+    bool RemoveWatchpoint(uint16_t begin, uint32_t end, Watchpoint::Type type);
+
+    inline bool IsStopRequested(void) const { return this->stopReason != StopNone; }
+    inline StopReason GetStopReason(void) const { return this->stopReason; }
+    inline uint16_t GetStopPC(void) const { return this->stopPC; }
+    inline const WatchHit& GetWatchHit(void) const { return this->watchHit; }
+    inline void ClearStop(void) { this->stopReason = StopNone; }
+
+    /* Memory access bypassing watchpoints, for debugger front-ends */
+    uint8_t PeekByte(uint16_t address) const;
+    void PokeByte(uint16_t address, uint8_t byte);
+
+    /* Called by the CPU and the watchpoints */
+    inline void OnBreakpoint(uint16_t pc)
+    {
+        this->stopReason = StopBreakpoint;
+        this->stopPC = pc;
+    }
+    void OnWatch(uint16_t address, Watchpoint::Type type, uint8_t value, Watchpoint::Type watched);
+
+    /* Only the accesses of the CPU hit watchpoints, not DMA nor front-ends reading memory */
+    inline bool IsCPUAccess(uint16_t address, bool write) const
+    {
+        return this->bus.IsAccessing(address, write);
+    }
+};
+
+};
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef GBEMU_GDB_SERVER_HPP
+#define GBEMU_GDB_SERVER_HPP
+
+#include <cstdint>
+#include <string>
+
+#include "cpu/CPU.hpp"
+#include "debug/Debugger.hpp"
+#include "memory/MemoryMap.hpp"
+
+namespace GameBoy
+{
+
+/**
+ * GDB remote serial protocol stub
+ *
+ * Serves a single client over TCP (localhost only) or a Unix socket.
+ * Registers are exposed in the order a, f, b, c, d, e, h, l (8 bits) then
+ * sp, pc (16 bits, little endian), as described by the target.xml served
+ * through qXfer. Z0/Z1 map to PC breakpoints, Z2/Z3/Z4 to write, read and
+ * access watchpoints. Between stops the CPU runs a frame at a time through
+ * CPU::Run(), checking for a client interrupt (Ctrl-C) after each frame.
+ */
+class GDBServer
+{
+private:
+    static const uint64_t RunCycles = 70224;
+
+    MemoryMap& mmap;
+    CPU& cpu;
+    Debugger& debugger;
+
+    int listenFd;
+    int fd;
+    bool noAck;
+
+    /* Bytes received, consumed up to inputOffset */
+    std::string input;
+    size_t inputOffset;
+
+    bool ReadByte(char& c);
+    bool ReceivePacket(std::string& packet);
+    void SendPacket(const std::string& payload);
+    bool IsInterruptPending(void);
+
+    std::string GetStopReply(void) const;
+    std::string ReadRegisters(void) const;
+    void WriteRegisters(const std::string& hex);
+    std::string ReadMemory(const std::string& arguments) const;
+    bool WriteMemory(const std::string& arguments);
+    bool SetBreakpoint(const std::string& arguments, bool insert);
+    std::string ReadFeatures(const std::string& arguments) const;
+
+    std::string Continue(void);
+    std::string Step(void);
+
+public:
+    GDBServer(MemoryMap& mmap, CPU& cpu, Debugger& debugger);
+    ~GDBServer();
+
+    void ListenTCP(uint16_t port);
+    void ListenUnix(const std::string& path);
+
+    /* Waits for a client and serves it until it detaches or kills the target */
+    void Serve(void);
+};
+
+};
+
+#endif
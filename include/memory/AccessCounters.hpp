@@ -0,0 +1,73 @@
+#ifndef GBEMU_ACCESS_COUNTERS_HPP
+#define GBEMU_ACCESS_COUNTERS_HPP
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace GameBoy
+{
+
+class MemoryMap;
+
+/**
+ * Memory access heatmap
+ *
+ * MemoryMap only feeds these counters when built with GBEMU_PROFILE (make
+ * PROFILE=1). Accesses are counted per address, pages and segments are
+ * aggregated when reporting, which also lists every unmapped address that
+ * was touched. EndFrame() closes a bucket of the per-frame page histogram.
+ */
+class AccessCounters
+{
+public:
+    static const uint32_t PageSize = 0x100;
+    static const uint32_t NumberOfPages = 0x100;
+
+    struct Frame {
+        uint32_t reads[NumberOfPages];
+        uint32_t writes[NumberOfPages];
+    };
+
+private:
+    uint64_t reads[0x10000];
+    uint64_t writes[0x10000];
+
+    /* Page totals when the current frame began */
+    Frame frameStart;
+    std::vector<Frame> frames;
+
+    void GetPageTotals(Frame& totals) const;
+
+public:
+    AccessCounters() { this->Reset(); }
+
+    void Reset(void);
+
+    inline void CountRead(uint16_t address, uint32_t size = 1)
+    {
+        for (uint32_t i = 0; i < size; i++)
+            this->reads[(uint16_t) (address + i)]++;
+    }
+
+    inline void CountWrite(uint16_t address, uint32_t size = 1)
+    {
+        for (uint32_t i = 0; i < size; i++)
+            this->writes[(uint16_t) (address + i)]++;
+    }
+
+    inline uint64_t GetReads(uint16_t address) const  { return this->reads[address]; }
+    inline uint64_t GetWrites(uint16_t address) const { return this->writes[address]; }
+
+    inline const std::vector<Frame>& GetFrames(void) const { return this->frames; }
+
+    /* Records the accesses per page since the previous call */
+    void EndFrame(void);
+
+    /* Writes totals per segment, unmapped addresses, pages and frames */
+    void Report(FILE *out, const MemoryMap& mmap) const;
+};
+
+};
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef GBEMU_IOSEGMENT_HPP
+#define GBEMU_IOSEGMENT_HPP
+
+#include <cstdint>
+#include <string>
+#include <stdexcept>
+
+#include "memory/MemorySegment.hpp"
+
+namespace GameBoy
+{
+
+/* Hardware block exposing memory-mapped registers */
+class IODevice
+{
+public:
+    virtual ~IODevice() {}
+
+    virtual uint8_t ReadRegister(uint16_t address) = 0;
+    virtual void WriteRegister(uint16_t address, uint8_t byte) = 0;
+};
+
+/* Segment forwarding every access to the registers of a device */
+class IOSegment : public MemorySegment
+{
+private:
+    IODevice *device;
+
+public:
+    IOSegment(
+        const std::string& name,
+        uint16_t begin, uint32_t end,
+        IODevice *device)
+    : MemorySegment(name, begin, end, Permissions::ReadWrite, nullptr), device(device)
+    {
+    }
+
+    void Load(uint16_t address, uint8_t *bytes, uint16_t size) const
+    {
+        if (!this->ContainsRange(address, size))
+            throw std::runtime_error("Address out of bounds in segment");
+
+        for (uint16_t i = 0; i < size; i++)
+            bytes[i] = this->device->ReadRegister(address + i);
+    }
+
+    inline uint8_t LoadByte(uint16_t address) const
+    {
+        return this->device->ReadRegister(address);
+    }
+
+    void Write(uint16_t address, const uint8_t *bytes, uint16_t size)
+    {
+        if (!this->ContainsRange(address, size))
+            throw std::runtime_error("Address out of bounds in segment");
+
+        for (uint16_t i = 0; i < size; i++)
+            this->device->WriteRegister(address + i, bytes[i]);
+    }
+
+    inline void WriteByte(uint16_t address, const uint8_t byte)
+    {
+        this->device->WriteRegister(address, byte);
+    }
+};
+
+};
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef GBEMU_MEMORYBANKS_HPP
+#define GBEMU_MEMORYBANKS_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "memory/MemoryMap.hpp"
+
+namespace GameBoy
+{
+
+/**
+ * Backing store of banks switched into one window of the address space, such
+ * as CGB WRAM and VRAM, for looking at all of them rather than the one mapped.
+ *
+ * Writes through the window only mark pages of the memory map dirty, so each
+ * switch moves the dirty pages of the window over to the bank being left.
+ * Once a window is tracked here, its dirty pages must be taken from here and
+ * not from the memory map.
+ */
+class MemoryBanks
+{
+public:
+    static const uint32_t PageSize = 0x100;
+
+private:
+    MemoryMap& mmap;
+    const uint8_t *memory;
+    uint16_t window;
+    uint32_t bankSize;
+    int nBanks;
+    int current;
+
+    /* One flag per page of every bank, all set to begin with */
+    std::vector<uint8_t> dirtyPages;
+
+    inline uint32_t GetPagesPerBank(void) const { return this->bankSize / PageSize; }
+
+public:
+    MemoryBanks(MemoryMap& mmap, const uint8_t *memory, uint16_t window, uint32_t bankSize, int nBanks)
+    : mmap(mmap), memory(memory), window(window), bankSize(bankSize), nBanks(nBanks), current(0),
+      dirtyPages(nBanks * (bankSize / PageSize), 1)
+    {
+    }
+
+    inline uint16_t GetWindow(void) const { return this->window; }
+    inline uint32_t GetBankSize(void) const { return this->bankSize; }
+    inline int GetBanks(void) const { return this->nBanks; }
+    inline int GetCurrent(void) const { return this->current; }
+
+    inline const uint8_t *GetPage(int bank, uint32_t page) const
+    {
+        return this->memory + bank * this->bankSize + page * PageSize;
+    }
+
+    /* To be called by the owner along with repointing its segment */
+    void Switch(int bank)
+    {
+        uint8_t *dirty = &this->dirtyPages[this->current * this->GetPagesPerBank()];
+        for (uint32_t page = 0; page < this->GetPagesPerBank(); page++) {
+            if (this->mmap.TakeDirty((this->window >> 8) + page))
+                dirty[page] = 1;
+        }
+
+        this->current = bank;
+    }
+
+    /* Whether page of bank was written to since the last call, which clears it */
+    bool TakeDirty(int bank, uint32_t page)
+    {
+        uint8_t& dirty = this->dirtyPages[bank * this->GetPagesPerBank() + page];
+        bool mapped = bank == this->current && this->mmap.TakeDirty((this->window >> 8) + page);
+        bool taken = dirty || mapped;
+
+        dirty = 0;
+        return taken;
+    }
+};
+
+};
+
+#endif
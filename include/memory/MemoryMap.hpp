@@ -1,9 +1,12 @@
 #ifndef GBEMU_MMAP_HPP
 #define GBEMU_MMAP_HPP
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <vector>
 
+#include "memory/AccessCounters.hpp"
 #include "memory/MemoryInterface.hpp"
 #include "memory/MemorySegment.hpp"
 
@@ -15,10 +18,41 @@ class MemoryMap : public MemoryInterface
 private:
     std::vector<MemorySegment*> segments;
 
+    /* One flag per 256-byte page, set by every write until taken */
+    uint8_t dirtyPages[256];
+
+#ifdef GBEMU_PROFILE
+    AccessCounters *counters = nullptr;
+#endif
+
 public:
     MemoryMap() {
+        std::memset(this->dirtyPages, 1, sizeof(this->dirtyPages));
+
         this->AddSegment(new MemorySegment("WRAM0", 0xC000, 0xD000, GameBoy::MemorySegment::Permissions::ReadWrite));
         this->AddSegment(new MemorySegment("WRAM1", 0xD000, 0xE000, GameBoy::MemorySegment::Permissions::ReadWrite));
+        this->AddSegment(new MemorySegment("HRAM", 0xFF80, 0xFFFF, GameBoy::MemorySegment::Permissions::ReadWrite));
+    }
+
+#ifdef GBEMU_PROFILE
+    inline void SetAccessCounters(AccessCounters *counters)
+    {
+        this->counters = counters;
+    }
+#endif
+
+    /* For writes bypassing the map, such as debugger pokes */
+    inline void MarkDirty(uint16_t address)
+    {
+        this->dirtyPages[address >> 8] = 1;
+    }
+
+    /* Whether page was written to since the last call, which clears it */
+    inline bool TakeDirty(uint8_t page)
+    {
+        bool dirty = this->dirtyPages[page];
+        this->dirtyPages[page] = 0;
+        return dirty;
     }
 
     void AddSegment(MemorySegment *segment)
@@ -26,6 +60,33 @@ public:
         segments.push_back(segment);
     }
 
+    /* Maps segment over everything already mapped in its range */
+    void InsertSegment(MemorySegment *segment)
+    {
+        this->segments.insert(this->segments.begin(), segment);
+    }
+
+    void RemoveSegment(MemorySegment *segment)
+    {
+        this->segments.erase(
+            std::remove(this->segments.begin(), this->segments.end(), segment),
+            this->segments.end());
+    }
+
+    /* Segment that would serve address if above (and those before it) were unmapped */
+    MemorySegment* GetSegmentBelow(const MemorySegment *above, uint16_t address) const
+    {
+        auto it = std::find(this->segments.begin(), this->segments.end(), above);
+        if (it == this->segments.end())
+            return nullptr;
+
+        for (++it; it != this->segments.end(); ++it) {
+            if ((*it)->ContainsAddress(address))
+                return *it;
+        }
+        return nullptr;
+    }
+
     MemorySegment* GetSegment(uint16_t address) const
     {
         /* TODO: use smart pointers */
@@ -36,22 +97,71 @@ public:
         return nullptr;
     }
 
+    /**
+     * Find the segment serving address, and how many bytes starting at address
+     * it serves before another segment (or the end of the address space) takes
+     * over. When no segment maps address, span is the size of the hole.
+     */
+    MemorySegment* GetSegment(uint16_t address, uint32_t& span) const
+    {
+        span = 0x10000 - address;
+
+        for (MemorySegment *segment : this->segments) {
+            if (segment->ContainsAddress(address)) {
+                span = std::min(span, segment->GetEnd() - address);
+                return segment;
+            }
+
+            /* A segment added earlier takes precedence where it begins */
+            if (segment->GetBegin() > address)
+                span = std::min(span, (uint32_t) segment->GetBegin() - address);
+        }
+
+        return nullptr;
+    }
+
     void Load(uint16_t address, uint8_t *bytes, uint16_t size) const
     {
-        /* TODO: see for cross segments accesses */
-        /*if (address >= 0xFF00 && address < 0xFF7F)
-            printf("read access to I/O register %04X\n", address);
-        */
-        MemorySegment *segment = this->GetSegment(address);
-        if (segment)
-            segment->Load(address, bytes, size);
+#ifdef GBEMU_PROFILE
+        if (this->counters)
+            this->counters->CountRead(address, size);
+#endif
+
+        this->Peek(address, bytes, size);
+    }
+
+    /* Same as Load() without being counted, for tools looking at memory rather than the CPU */
+    void Peek(uint16_t address, uint8_t *bytes, uint16_t size) const
+    {
+        uint32_t remaining = size;
+        while (remaining > 0) {
+            uint32_t span;
+            MemorySegment *segment = this->GetSegment(address, span);
+            uint16_t chunk = std::min(span, remaining);
+
+            /* Unmapped addresses read as an open bus */
+            if (segment)
+                segment->Load(address, bytes, chunk);
+            else
+                std::memset(bytes, 0xFF, chunk);
+
+            bytes += chunk;
+            remaining -= chunk;
+            address += chunk;
+        }
     }
 
     inline uint8_t LoadByte(uint16_t address) const
     {
-        uint8_t byte;
-        this->Load(address, &byte, sizeof(byte));
-        return byte;
+#ifdef GBEMU_PROFILE
+        if (this->counters)
+            this->counters->CountRead(address);
+#endif
+
+        MemorySegment *segment = this->GetSegment(address);
+        if (segment)
+            return segment->LoadByte(address);
+        return 0xFF;
     }
 
     inline uint16_t LoadHalfWord(uint16_t address) const
@@ -63,17 +173,41 @@ public:
 
     void Write(uint16_t address, const uint8_t *bytes, uint16_t size)
     {
-        /*if (address >= 0xFF00 && address < 0xFF7F)
-            printf("write access to I/O register %04X\n", address);
-        */
-        MemorySegment *segment = this->GetSegment(address);
-        if (segment)
-            segment->Write(address, bytes, size);
+#ifdef GBEMU_PROFILE
+        if (this->counters)
+            this->counters->CountWrite(address, size);
+#endif
+
+        for (uint32_t page = address >> 8; size > 0 && page <= (uint32_t) (address + size - 1) >> 8; page++)
+            this->dirtyPages[page & 0xFF] = 1;
+
+        uint32_t remaining = size;
+        while (remaining > 0) {
+            uint32_t span;
+            MemorySegment *segment = this->GetSegment(address, span);
+            uint16_t chunk = std::min(span, remaining);
+
+            if (segment)
+                segment->Write(address, bytes, chunk);
+
+            bytes += chunk;
+            remaining -= chunk;
+            address += chunk;
+        }
     }
 
     inline void WriteByte(uint16_t address, const uint8_t byte)
     {
-        this->Write(address, &byte, sizeof(byte));
+#ifdef GBEMU_PROFILE
+        if (this->counters)
+            this->counters->CountWrite(address);
+#endif
+
+        this->dirtyPages[address >> 8] = 1;
+
+        MemorySegment *segment = this->GetSegment(address);
+        if (segment)
+            segment->WriteByte(address, byte);
     }
 
     inline void WriteHalfWord(uint16_t address, uint16_t halfword) 
@@ -84,4 +218,4 @@ public:
 
 };
 
-#endif
\ No newline at end of file
+#endif
\ No newline at end of file
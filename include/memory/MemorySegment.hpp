@@ -2,6 +2,7 @@
 #define GBEMU_MEMORYSEGMENT_HPP
 
 #include <cstdint>
+#include <cstring>
 #include <string>
 #include <stdexcept>
 
@@ -22,7 +23,8 @@ public:
 private:
     std::string name;
     uint16_t begin;
-    uint16_t end;
+    /* Exclusive bound, wide enough for a segment ending at 0xFFFF */
+    uint32_t end;
     Permissions perms;
 
     uint8_t *memory;
@@ -33,16 +35,17 @@ private:
 public:
     MemorySegment(
         const std::string& name, 
-        uint16_t begin, uint16_t end, 
+        uint16_t begin, uint32_t end, 
         Permissions perms)
     : name(name), begin(begin), end(end), perms(perms), isAnonymous(true)
     {
-        this->memory = new uint8_t [end - begin];
+        /* Zeroed rather than random like on hardware, runs must be reproducible */
+        this->memory = new uint8_t [end - begin]();
     }
 
     MemorySegment(
         const std::string& name, 
-        uint16_t begin, uint16_t end, 
+        uint16_t begin, uint32_t end, 
         Permissions perms,
         uint8_t *memory)
     : name(name), begin(begin), end(end), perms(perms), memory(memory), isAnonymous(false)
@@ -55,6 +58,18 @@ public:
             delete [] this->memory;
     }
 
+    /* Repoints the segment to switch banks, only over memory owned by the caller */
+    void SetMemory(uint8_t *memory)
+    {
+        if (this->isAnonymous)
+            throw std::runtime_error("Cannot repoint an anonymous segment");
+        this->memory = memory;
+    }
+
+    inline const std::string& GetName(void) const { return this->name; }
+    inline uint16_t GetBegin(void) const { return this->begin; }
+    inline uint32_t GetEnd(void) const { return this->end; }
+
     inline bool ContainsAddress(uint16_t address) const
     {
         if (this->begin <= address && address < this->end)
@@ -62,21 +77,25 @@ public:
         return false;
     }
 
+    inline bool ContainsRange(uint16_t address, uint32_t size) const
+    {
+        return this->begin <= address && (uint32_t) address + size <= this->end;
+    }
+
     void Load(uint16_t address, uint8_t *bytes, uint16_t size) const
     {
-        for (uint16_t i = 0; i < size; i++) {
-            if (!this->ContainsAddress(address + i))
-                throw std::runtime_error("Address out of bounds in segment");
+        if (!this->ContainsRange(address, size))
+            throw std::runtime_error("Address out of bounds in segment");
 
-            bytes[i] = this->memory[address - this->begin + i];
-        }
+        std::memcpy(bytes, &this->memory[address - this->begin], size);
     }
 
     inline uint8_t LoadByte(uint16_t address) const
     {
-        uint8_t byte;
-        this->Load(address, &byte, sizeof(byte));
-        return byte;
+        if (!this->ContainsAddress(address))
+            throw std::runtime_error("Address out of bounds in segment");
+
+        return this->memory[address - this->begin];
     }
 
     uint16_t LoadHalfWord(uint16_t address) const
@@ -88,20 +107,18 @@ public:
 
     void Write(uint16_t address, const uint8_t *bytes, uint16_t size)
     {
-        for (uint16_t i = 0; i < size; i++) {
-            if (address + i >= 0xffff)
-                break;
-            
-            if (!this->ContainsAddress(address + i))
-                throw std::runtime_error("Address out of bounds in segment");
-
-            this->memory[address - this->begin + i] = bytes[i];
-        }
+        if (!this->ContainsRange(address, size))
+            throw std::runtime_error("Address out of bounds in segment");
+
+        std::memcpy(&this->memory[address - this->begin], bytes, size);
     }
 
     inline void WriteByte(uint16_t address, const uint8_t byte)
     {
-        this->Write(address, &byte, sizeof(byte));
+        if (!this->ContainsAddress(address))
+            throw std::runtime_error("Address out of bounds in segment");
+
+        this->memory[address - this->begin] = byte;
     }
 
     inline void WriteHalfWord(uint16_t address, uint16_t halfword) 
@@ -0,0 +1,95 @@
+#ifndef GBEMU_REFERENCE_TRACE_HPP
+#define GBEMU_REFERENCE_TRACE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "trace/Trace.hpp"
+
+namespace GameBoy
+{
+
+/**
+ * Reference trace for lockstep comparison
+ *
+ * The file is memory-mapped and never parsed: the emulator state is rendered
+ * in the layout of the reference once per instruction and compared with
+ * memcmp, which is vectorized. Two layouts are supported:
+ *  - gameboy-doctor logs, one line per instruction:
+ *    "A:01 F:B0 B:00 C:13 D:00 E:D8 H:01 L:4D SP:FFFE PC:0100 PCMEM:00,C3,13,02"
+ *  - uncompressed binary traces written by TraceWriter, compared record by
+ *    record including the cycle count
+ */
+class ReferenceTrace
+{
+public:
+    enum Format {
+        FormatDoctor,
+        FormatBinary,
+    };
+
+    /* Length of a gameboy-doctor line, without the line ending */
+    static const size_t DoctorLineLength = 73;
+
+private:
+    enum Format format;
+
+    const uint8_t *data;
+    size_t size;
+
+    /* Current entry, and end of its chunk for binary traces */
+    size_t offset;
+    size_t chunkEnd;
+    uint64_t index;
+
+    /* Offset of the entry following the one at offset */
+    size_t NextOffset(size_t offset, size_t& chunkEnd) const;
+
+public:
+    ReferenceTrace(const std::string& path);
+    ~ReferenceTrace();
+
+    inline enum Format GetFormat(void) const { return this->format; }
+    inline bool AtEnd(void) const { return this->offset >= this->size; }
+
+    /* Index of the current entry */
+    inline uint64_t GetIndex(void) const { return this->index; }
+
+    /**
+     * Compares state with the current entry, advances past it if they match.
+     * pcmem holds the 4 bytes at PC, as logged by gameboy-doctor.
+     */
+    inline bool Compare(const TraceRecord& state, const uint8_t *pcmem)
+    {
+        if (this->AtEnd())
+            return false;
+
+        if (this->format == FormatBinary) {
+            if (std::memcmp(&state, this->data + this->offset, offsetof(TraceRecord, reserved)) != 0)
+                return false;
+        } else {
+            char line[DoctorLineLength];
+            FormatDoctorLine(state, pcmem, line);
+            if (this->size - this->offset < DoctorLineLength
+                || std::memcmp(line, this->data + this->offset, DoctorLineLength) != 0)
+                return false;
+        }
+
+        this->offset = this->NextOffset(this->offset, this->chunkEnd);
+        this->index++;
+        return true;
+    }
+
+    /* Writes the entry n entries after the current one, false past the end */
+    bool PrintEntry(FILE *out, uint64_t n) const;
+
+    /* Renders state as a gameboy-doctor line, without the line ending */
+    static void FormatDoctorLine(const TraceRecord& state, const uint8_t *pcmem, char *line);
+};
+
+};
+
+#endif
@@ -0,0 +1,112 @@
+#ifndef GBEMU_REPLAY_HPP
+#define GBEMU_REPLAY_HPP
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "cpu/CPU.hpp"
+#include "memory/MemoryBanks.hpp"
+#include "memory/MemoryMap.hpp"
+#include "Scheduler.hpp"
+
+namespace GameBoy
+{
+
+/**
+ * Periodic state hashes of a run
+ *
+ * A replay file is a ReplayHeader followed by a ReplayCheckpoint every
+ * interval frames, each holding a hash of the CPU registers and of all the
+ * memory outside the I/O registers, switched out banks included. Running the same blob with the same
+ * input again must produce the same checkpoints, so comparing them tells the
+ * first frame at which two runs diverged.
+ */
+
+struct ReplayHeader {
+    char magic[4];          /* "GBRP" */
+    uint16_t version;
+    uint16_t reserved;
+    uint32_t recordSize;
+    uint32_t interval;
+};
+
+struct ReplayCheckpoint {
+    uint64_t frame;
+    uint64_t cycles;
+    uint64_t hash;
+};
+
+/**
+ * Hashes are kept per 256-byte page, and only the pages the memory map saw
+ * written since the previous call are hashed again, so a checkpoint costs
+ * about as much as the memory written in between. Banked windows are hashed
+ * bank by bank from their backing store instead, with the bank mapped.
+ */
+class StateHasher
+{
+private:
+    MemoryMap& mmap;
+    uint64_t pageHashes[256];
+    /* Pages served by one of the banks */
+    bool banked[256];
+
+    std::vector<MemoryBanks*> banks;
+    std::vector<std::vector<uint64_t>> bankHashes;
+
+    uint64_t HashPage(uint8_t page) const;
+
+public:
+    StateHasher(MemoryMap& mmap, const std::vector<MemoryBanks*>& banks);
+
+    uint64_t Hash(CPU& cpu);
+};
+
+/* Records checkpoints, or checks them against a previous recording */
+class ReplayLog : public Schedulable
+{
+public:
+    enum Mode {
+        ModeRecord,
+        ModeVerify
+    };
+
+private:
+    CPU& cpu;
+    StateHasher hasher;
+    FILE *file;
+    Mode mode;
+    uint32_t interval;
+    int eventId;
+
+    uint64_t frame;
+    size_t nCheckpoints;
+    bool atEnd;
+    bool diverged;
+    ReplayCheckpoint expected;
+    ReplayCheckpoint actual;
+
+    /* Verifying reads one checkpoint ahead to know where the recording ends */
+    bool ReadExpected(void);
+
+public:
+    /* interval is only used when recording, verifying uses the recorded one */
+    ReplayLog(MemoryMap& mmap, CPU& cpu, const std::vector<MemoryBanks*>& banks,
+              const std::string& path, Mode mode, uint32_t interval = 1);
+    ~ReplayLog();
+
+    inline size_t GetCheckpoints(void) const { return this->nCheckpoints; }
+    /* Verifying went through every recorded checkpoint */
+    inline bool AtEnd(void) const { return this->atEnd; }
+
+    inline bool HasDiverged(void) const { return this->diverged; }
+    inline const ReplayCheckpoint& GetExpected(void) const { return this->expected; }
+    inline const ReplayCheckpoint& GetActual(void) const { return this->actual; }
+
+    void OnEvent(uint64_t deadline);
+};
+
+};
+
+#endif
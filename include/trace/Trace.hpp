@@ -0,0 +1,146 @@
+#ifndef GBEMU_TRACE_HPP
+#define GBEMU_TRACE_HPP
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cpu/Registers.hpp"
+
+namespace GameBoy
+{
+
+/**
+ * Binary execution trace
+ *
+ * A trace file is a TraceHeader followed by chunks, each being a
+ * TraceChunkHeader and its payload. The payload is either the raw records or,
+ * with TraceCompressed, every record delta-encoded against the previous one
+ * of the chunk: a 24-bit mask of the bytes that changed, then those bytes.
+ * Consecutive instructions share most of their state, so this typically
+ * shrinks records from 24 to 8-10 bytes. Chunks decode independently.
+ */
+
+/* State before executing the instruction at pc */
+struct TraceRecord {
+    uint64_t cycles;
+    uint16_t pc;
+    uint16_t sp;
+    uint8_t a, f, b, c, d, e, h, l;
+    uint8_t bytecode[3];
+    uint8_t reserved;
+
+    inline void SetRegisters(const Registers& registers)
+    {
+        this->pc = registers.pc;
+        this->sp = registers.sp;
+        this->a = registers.a;
+        this->f = registers.f;
+        this->b = registers.b;
+        this->c = registers.c;
+        this->d = registers.d;
+        this->e = registers.e;
+        this->h = registers.h;
+        this->l = registers.l;
+        this->reserved = 0;
+    }
+};
+
+static_assert(sizeof(TraceRecord) == 24, "TraceRecord must stay packed");
+
+enum TraceFlags : uint16_t {
+    TraceCompressed = 0x0001,
+};
+
+struct TraceHeader {
+    char magic[4];          /* "GBTR" */
+    uint16_t version;
+    uint16_t flags;
+    uint32_t recordSize;
+    uint32_t reserved;
+};
+
+struct TraceChunkHeader {
+    uint32_t nRecords;
+    uint32_t payloadSize;
+};
+
+/**
+ * Appending only copies the record into the current buffer. Full buffers are
+ * handed to a writer thread which encodes and writes them, so the emulation
+ * thread never formats, compresses or blocks on I/O unless the writer falls
+ * behind by more than a few buffers.
+ */
+class TraceWriter
+{
+private:
+    FILE *file;
+    bool compress;
+    size_t capacity;
+
+    std::vector<TraceRecord> active;
+
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<std::vector<TraceRecord>> pending;
+    std::vector<std::vector<TraceRecord>> spare;
+    bool closing;
+
+    static const size_t MaxPending = 4;
+
+    void Submit(void);
+    void Work(void);
+    void WriteChunk(const std::vector<TraceRecord>& records, std::vector<uint8_t>& payload);
+
+public:
+    TraceWriter(const std::string& path, bool compress, size_t capacity = 1 << 16);
+    ~TraceWriter();
+
+    inline void Append(const TraceRecord& record)
+    {
+        if (this->active.size() == this->capacity)
+            this->Submit();
+        this->active.push_back(record);
+    }
+
+    /* Flushes everything and waits for the writer thread */
+    void Close(void);
+};
+
+class TraceReader
+{
+private:
+    FILE *file;
+    TraceHeader header;
+
+    std::vector<TraceRecord> records;
+    std::vector<uint8_t> payload;
+    size_t position;
+
+    bool ReadChunk(void);
+
+public:
+    TraceReader(const std::string& path);
+    ~TraceReader();
+
+    inline bool IsCompressed(void) const { return this->header.flags & TraceCompressed; }
+
+    /* Returns false at the end of the trace */
+    inline bool Next(TraceRecord& record)
+    {
+        if (this->position == this->records.size() && !this->ReadChunk())
+            return false;
+        record = this->records[this->position++];
+        return true;
+    }
+};
+
+};
+
+#endif
@@ -0,0 +1,104 @@
+"""
+Generate the instruction tables from the checked-in opcode description.
+
+usage:
+    GenerateInstructionSet.py tables <opcodes.json> <InstructionSet.cpp>
+
+Only the standard library is used so that it runs on offline machines.
+"""
+
+import json
+import sys
+
+IMMEDIATES = {"NoImmediate": 0, "Immediate8": 1, "Immediate16": 2}
+BRANCHES = [
+    "None", "Jump", "JumpConditional", "JumpRelative", "JumpRelativeConditional",
+    "JumpIndirect", "Call", "CallConditional", "Return", "ReturnConditional",
+    "ReturnInterrupt", "Restart", "Halt", "Illegal",
+]
+FLAGS = "ZNHC"
+
+HEADER = "/* Generated by scripts/GenerateInstructionSet.py from scripts/opcodes.json, do not edit */"
+
+
+def load_tables(path):
+    with open(path) as f:
+        description = json.load(f)
+
+    tables = (description["main"], description["cb"])
+    for cb, table in enumerate(tables):
+        if len(table) != 0x100:
+            raise ValueError("expected 256 entries, got {}".format(len(table)))
+
+        for n, entry in enumerate(table):
+            where = "{}{:02X}".format("CB " if cb else "", n)
+
+            if int(entry["opcode"], 16) != n:
+                raise ValueError("{}: entries out of order".format(where))
+            if entry["immediate"] not in IMMEDIATES:
+                raise ValueError("{}: bad immediate type".format(where))
+            if entry["branch"] not in BRANCHES:
+                raise ValueError("{}: bad branch kind".format(where))
+            for field in ("flagsRead", "flagsWritten"):
+                if any(flag not in FLAGS for flag in entry[field]):
+                    raise ValueError("{}: bad flags in {}".format(where, field))
+
+            length = 1 + cb + IMMEDIATES[entry["immediate"]]
+            if entry["length"] != length:
+                raise ValueError("{}: length does not match the immediate".format(where))
+            if entry["cyclesTaken"] < entry["cycles"]:
+                raise ValueError("{}: taken branch faster than not taken".format(where))
+
+    return tables
+
+
+def flags_to_c(flags):
+    if not flags:
+        return "FlagNone"
+    return " | ".join("Flag" + flag for flag in flags)
+
+
+def entry_to_c(entry):
+    return "    {{\"{}\", {}, {}, {}, {}, {}, {}, Branch{}}},".format(
+        entry["format"], entry["immediate"], entry["length"],
+        entry["cycles"], entry["cyclesTaken"],
+        flags_to_c(entry["flagsRead"]), flags_to_c(entry["flagsWritten"]),
+        entry["branch"])
+
+
+def tables_to_c(tables):
+    lines = [
+        HEADER,
+        "#include \"cpu/Instruction.hpp\"",
+        "",
+        "namespace GameBoy",
+        "{",
+        "",
+        "/* format, immediate, length, cycles, cycles if taken, flags read, flags written, branch */",
+    ]
+
+    for name, table in zip(("InstructionTable", "InstructionTableCB"), tables):
+        lines.append("constexpr AbstractInstruction {}[256] = {{".format(name))
+        lines.extend(entry_to_c(entry) for entry in table)
+        lines.append("};")
+        lines.append("")
+
+    lines.append("};")
+    return lines
+
+
+def main(argv):
+    if len(argv) != 4 or argv[1] != "tables":
+        print(__doc__.strip())
+        return 1
+
+    lines = tables_to_c(load_tables(argv[2]))
+
+    with open(argv[3], "w", newline="\r\n") as f:
+        f.write("\n".join(lines))
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
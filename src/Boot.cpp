@@ -0,0 +1,185 @@
+#include <fstream>
+#include <stdexcept>
+
+#include "Boot.hpp"
+
+namespace GameBoy
+{
+
+BootROM::BootROM(MemoryMap& mmap, const std::string& path)
+: mmap(mmap), highSegment(nullptr), mapped(true)
+{
+    std::ifstream handler(path, std::ifstream::ate | std::ifstream::binary);
+    if (handler.fail())
+        throw std::runtime_error("Boot ROM file not found");
+
+    this->contents.resize(handler.tellg());
+    if (this->contents.size() != DMGSize && this->contents.size() != CGBSize)
+        throw std::runtime_error("Boot ROM is neither a DMG nor a CGB one");
+
+    handler.seekg(0);
+    handler.read(reinterpret_cast<char*>(this->contents.data()), this->contents.size());
+
+    this->lowSegment = new MemorySegment(
+        "BOOT", 0x0000, 0x0100,
+        GameBoy::MemorySegment::Permissions::Read,
+        this->contents.data()
+    );
+    this->mmap.InsertSegment(this->lowSegment);
+
+    /* The CGB one skips the cartridge header */
+    if (this->IsColor()) {
+        this->highSegment = new MemorySegment(
+            "BOOT", 0x0200, CGBSize,
+            GameBoy::MemorySegment::Permissions::Read,
+            this->contents.data() + 0x0200
+        );
+        this->mmap.InsertSegment(this->highSegment);
+    }
+
+    this->segment = new IOSegment("BOOT", BOOTAddress, BOOTAddress + 1, this);
+    this->mmap.AddSegment(this->segment);
+}
+
+BootROM::~BootROM()
+{
+    this->Unmap();
+
+    delete this->segment;
+    delete this->lowSegment;
+    delete this->highSegment;
+}
+
+void BootROM::Unmap(void)
+{
+    if (!this->mapped)
+        return;
+
+    this->mmap.RemoveSegment(this->lowSegment);
+    if (this->highSegment)
+        this->mmap.RemoveSegment(this->highSegment);
+    this->mapped = false;
+
+    /* The cartridge shows through from now on */
+    for (uint32_t address = 0; address < this->contents.size(); address += 0x100)
+        this->mmap.MarkDirty(address);
+}
+
+uint8_t BootROM::ReadRegister(uint16_t)
+{
+    return this->mapped ? 0xFE : 0xFF;
+}
+
+void BootROM::WriteRegister(uint16_t, uint8_t byte)
+{
+    if (byte)
+        this->Unmap();
+}
+
+struct RegisterWrite {
+    uint16_t address;
+    uint8_t byte;
+};
+
+/**
+ * What both boot ROMs write and leave in the I/O registers, in order: the APU
+ * has to be powered before its registers take writes, and the last notes of
+ * the boot sound are still playing on channel 1 at 0x0100. Registers that
+ * already come out of reset with their post-boot value are left out.
+ */
+static const RegisterWrite PostBootWrites[] = {
+    { 0xFF00, 0xCF },   /* P1, both button groups selected */
+    { 0xFF07, 0xF8 },   /* TAC */
+    { 0xFF26, 0x80 },   /* NR52 */
+    { 0xFF11, 0x80 },   /* NR11 */
+    { 0xFF12, 0xF3 },   /* NR12 */
+    { 0xFF25, 0xF3 },   /* NR51 */
+    { 0xFF24, 0x77 },   /* NR50 */
+    { 0xFF13, 0xC1 },   /* NR13 */
+    { 0xFF14, 0x87 },   /* NR14, triggers channel 1 */
+    { 0xFF42, 0x00 },   /* SCY, at the end of the logo scroll */
+    { 0xFF47, 0xFC },   /* BGP */
+    { 0xFF40, 0x91 },   /* LCDC */
+    { 0xFF0F, 0xE1 },   /* IF, VBlank pending */
+};
+
+/* Internal divider at 0x0100, DIV being its upper byte */
+static const uint16_t DMGDivider = 0xABCC;
+static const uint16_t CGBDivider = 0x1EA0;
+
+/* (R) tile of the DMG boot ROM */
+static const uint8_t RegisteredTile[] = { 0x3C, 0x42, 0xB9, 0xA5, 0xB9, 0xA5, 0x42, 0x3C };
+
+/* Same decompression as the DMG boot ROM: each nibble of the header logo becomes two rows of a tile */
+static void LoadLogo(MemoryMap& mmap)
+{
+    uint16_t tiles = 0x8010;
+
+    for (uint16_t address = 0x0104; address < 0x0134; address++) {
+        uint8_t byte = mmap.LoadByte(address);
+
+        for (int shift = 4; shift >= 0; shift -= 4) {
+            uint8_t row = 0;
+            for (int bit = 3; bit >= 0; bit--)
+                row = (row << 2) | (((byte >> (shift + bit)) & 1) ? 0x03 : 0x00);
+
+            /* Only the low bitplane, the high one stays clear */
+            mmap.WriteByte(tiles, row);
+            mmap.WriteByte(tiles + 2, row);
+            tiles += 4;
+        }
+    }
+
+    for (uint8_t row : RegisteredTile) {
+        mmap.WriteByte(tiles, row);
+        tiles += 2;
+    }
+
+    /* Tiles 1-12 on the first row, 13-24 on the second and (R) at the end of the first */
+    for (uint8_t tile = 1; tile <= 12; tile++) {
+        mmap.WriteByte(0x9903 + tile, tile);
+        mmap.WriteByte(0x9923 + tile, tile + 12);
+    }
+    mmap.WriteByte(0x9910, 0x19);
+}
+
+void FastBoot(MemoryMap& mmap, CPU& cpu, Timer& timer, bool color)
+{
+    Registers& registers = cpu.GetRegisters();
+
+    if (color) {
+        registers.SetAF(0x1180);
+        registers.SetBC(0x0000);
+        registers.SetDE(0xFF56);
+        registers.SetHL(0x000D);
+    } else {
+        /* H and C are left set unless the header checksum is zero */
+        registers.SetAF(mmap.LoadByte(0x014D) ? 0x01B0 : 0x0180);
+        registers.SetBC(0x0013);
+        registers.SetDE(0x00D8);
+        registers.SetHL(0x014D);
+    }
+    registers.sp = 0xFFFE;
+    cpu.SetPC(0x0100);
+
+    if (color) {
+        /* SC reads 0x7F, internal and fast clock selected */
+        mmap.WriteByte(0xFF02, 0x03);
+
+        /* Background palettes all white, the OBJ ones are left alone */
+        mmap.WriteByte(0xFF68, 0x80);
+        for (int i = 0; i < 32; i++) {
+            mmap.WriteByte(0xFF69, 0xFF);
+            mmap.WriteByte(0xFF69, 0x7F);
+        }
+    } else {
+        LoadLogo(mmap);
+    }
+
+    for (const RegisterWrite& write : PostBootWrites)
+        mmap.WriteByte(write.address, write.byte);
+
+    timer.SetDivider(color ? CGBDivider : DMGDivider);
+}
+
+};
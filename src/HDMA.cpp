@@ -0,0 +1,95 @@
+#include "HDMA.hpp"
+
+namespace GameBoy
+{
+
+HDMA::HDMA(MemoryMap& mmap, CPU& cpu, Video& video)
+: mmap(mmap), cpu(cpu), video(video),
+  source(0), destination(0), remaining(0x7F), active(false)
+{
+    this->segment = new IOSegment("HDMA", HDMA1Address, HDMA5Address + 1, this);
+    this->mmap.AddSegment(this->segment);
+
+    this->video.SetHBlankListener(this);
+}
+
+HDMA::~HDMA()
+{
+    this->video.SetHBlankListener(nullptr);
+    delete this->segment;
+}
+
+void HDMA::CopyBlock(void)
+{
+    uint8_t buffer[BlockSize];
+    this->mmap.Load(this->source, buffer, BlockSize);
+    this->mmap.Write(0x8000 | this->destination, buffer, BlockSize);
+
+    this->source += BlockSize;
+    this->destination = (this->destination + BlockSize) & 0x1FF0;
+    this->remaining = (this->remaining - 1) & 0x7F;
+
+    this->cpu.Stall(BlockCycles);
+}
+
+uint8_t HDMA::ReadRegister(uint16_t address)
+{
+    /* Bit 7 is set once the transfer completed or was cancelled */
+    if (address == HDMA5Address)
+        return (this->active ? 0 : 0x80) | this->remaining;
+    return 0xFF;
+}
+
+void HDMA::WriteRegister(uint16_t address, uint8_t byte)
+{
+    switch (address) {
+        case HDMA1Address:
+            this->source = (byte << 8) | (this->source & 0x00F0);
+            break;
+        case HDMA1Address + 1:
+            this->source = (this->source & 0xFF00) | (byte & 0xF0);
+            break;
+        case HDMA1Address + 2:
+            this->destination = ((byte & 0x1F) << 8) | (this->destination & 0x00F0);
+            break;
+        case HDMA1Address + 3:
+            this->destination = (this->destination & 0x1F00) | (byte & 0xF0);
+            break;
+        case HDMA5Address:
+            /* Writing bit 7 clear during an HBlank transfer cancels it */
+            if (this->active && !(byte & 0x80)) {
+                this->active = false;
+                break;
+            }
+
+            this->remaining = byte & 0x7F;
+
+            if (!(byte & 0x80)) {
+                do {
+                    this->CopyBlock();
+                } while (this->remaining != 0x7F);
+                break;
+            }
+
+            this->active = true;
+
+            /* Already in HBlank, or with the LCD off, the first block goes now */
+            if (this->video.IsHBlank())
+                this->OnHBlank(this->cpu.GetCycles());
+            break;
+        default:
+            break;
+    }
+}
+
+void HDMA::OnHBlank(uint64_t)
+{
+    if (!this->active)
+        return;
+
+    this->CopyBlock();
+    if (this->remaining == 0x7F)
+        this->active = false;
+}
+
+};
@@ -0,0 +1,92 @@
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "InputMovie.hpp"
+
+namespace GameBoy
+{
+
+static const char InputMovieMagic[4] = { 'G', 'B', 'I', 'M' };
+static const uint16_t InputMovieVersion = 1;
+
+InputMovieReader::InputMovieReader(const std::string& path)
+: data(nullptr), size(0), records(nullptr), nRecords(0), position(0), frames(false)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error("Cannot open input movie");
+
+    struct stat st;
+    if (fstat(fd, &st) < 0 || (size_t) st.st_size < sizeof(InputMovieHeader)) {
+        close(fd);
+        throw std::runtime_error("Input movie too short");
+    }
+
+    void *mapping = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED)
+        throw std::runtime_error("Cannot map input movie");
+
+    madvise(mapping, st.st_size, MADV_SEQUENTIAL);
+
+    this->data = static_cast<const uint8_t*>(mapping);
+    this->size = st.st_size;
+
+    const InputMovieHeader *header = reinterpret_cast<const InputMovieHeader*>(this->data);
+    if (std::memcmp(header->magic, InputMovieMagic, sizeof(InputMovieMagic)) != 0
+        || header->version != InputMovieVersion || header->recordSize != sizeof(InputRecord)) {
+        munmap(mapping, st.st_size);
+        throw std::runtime_error("Not a supported input movie");
+    }
+
+    this->frames = header->flags & InputMovieFrames;
+    this->records = reinterpret_cast<const InputRecord*>(this->data + sizeof(InputMovieHeader));
+    this->nRecords = (this->size - sizeof(InputMovieHeader)) / sizeof(InputRecord);
+}
+
+InputMovieReader::~InputMovieReader()
+{
+    munmap(const_cast<uint8_t*>(this->data), this->size);
+}
+
+InputMovieWriter::InputMovieWriter(const std::string& path, bool frames)
+{
+    this->file = std::fopen(path.c_str(), "wb");
+    if (!this->file)
+        throw std::runtime_error("Cannot open input movie");
+
+    InputMovieHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, InputMovieMagic, sizeof(header.magic));
+    header.version = InputMovieVersion;
+    header.flags = frames ? InputMovieFrames : 0;
+    header.recordSize = sizeof(InputRecord);
+
+    if (std::fwrite(&header, sizeof(header), 1, this->file) != 1) {
+        std::fclose(this->file);
+        throw std::runtime_error("Cannot write input movie");
+    }
+}
+
+InputMovieWriter::~InputMovieWriter()
+{
+    std::fclose(this->file);
+}
+
+void InputMovieWriter::Append(uint64_t time, uint8_t buttons)
+{
+    InputRecord record;
+    std::memset(&record, 0, sizeof(record));
+    record.time = time;
+    record.buttons = buttons;
+
+    if (std::fwrite(&record, sizeof(record), 1, this->file) != 1)
+        throw std::runtime_error("Cannot write input movie");
+}
+
+};
@@ -0,0 +1,92 @@
+#include "Joypad.hpp"
+#include "Video.hpp"
+
+namespace GameBoy
+{
+
+Joypad::Joypad(MemoryMap& mmap, CPU& cpu, InterruptController& interruptController)
+: mmap(mmap), cpu(cpu), interruptController(interruptController),
+  select(0x30), buttons(0), movie(nullptr), recorder(nullptr)
+{
+    this->segment = new IOSegment("JOYPAD", P1Address, P1Address + 1, this);
+    this->mmap.AddSegment(this->segment);
+
+    this->eventId = this->cpu.GetScheduler().Register(this);
+}
+
+Joypad::~Joypad()
+{
+    this->cpu.GetScheduler().Cancel(this->eventId);
+    delete this->segment;
+}
+
+void Joypad::Update(uint8_t select, uint8_t buttons)
+{
+    uint8_t before = this->GetLines();
+
+    this->select = select;
+    this->buttons = buttons;
+
+    /* Only falling lines request the interrupt */
+    if (before & ~this->GetLines())
+        this->interruptController.Request(InterruptController::InterruptJoypad);
+}
+
+void Joypad::SetButtons(uint8_t buttons)
+{
+    if (buttons == this->buttons)
+        return;
+
+    if (this->recorder)
+        this->recorder->Append(this->cpu.GetCycles(), buttons);
+    this->Update(this->select, buttons);
+}
+
+void Joypad::ScheduleMovie(void)
+{
+    this->cpu.GetScheduler().Cancel(this->eventId);
+    if (!this->movie || this->movie->AtEnd())
+        return;
+
+    uint64_t deadline = this->movie->Peek().time;
+    if (this->movie->IsInFrames())
+        deadline *= Video::FrameCycles;
+    this->cpu.GetScheduler().Schedule(this->eventId, deadline);
+}
+
+void Joypad::SetMovie(InputMovieReader *movie)
+{
+    this->movie = movie;
+
+    if (movie) {
+        uint64_t now = this->cpu.GetCycles();
+        uint64_t scale = movie->IsInFrames() ? Video::FrameCycles : 1;
+
+        /* The last record already past still holds, the others never will */
+        while (!movie->AtEnd() && movie->Peek().time * scale <= now) {
+            this->SetButtons(movie->Peek().buttons);
+            movie->Advance();
+        }
+    }
+
+    this->ScheduleMovie();
+}
+
+uint8_t Joypad::ReadRegister(uint16_t)
+{
+    return 0xC0 | this->select | this->GetLines();
+}
+
+void Joypad::WriteRegister(uint16_t, uint8_t byte)
+{
+    this->Update(byte & 0x30, this->buttons);
+}
+
+void Joypad::OnEvent(uint64_t)
+{
+    this->SetButtons(this->movie->Peek().buttons);
+    this->movie->Advance();
+    this->ScheduleMovie();
+}
+
+};
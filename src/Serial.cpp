@@ -0,0 +1,132 @@
+#include <algorithm>
+
+#include "Serial.hpp"
+
+namespace GameBoy
+{
+
+Serial::Serial(MemoryMap& mmap, CPU& cpu, InterruptController& interruptController)
+: mmap(mmap), cpu(cpu), interruptController(interruptController),
+  color(false), sb(0), sc(0), incoming(0xFF), transferStart(0), link(nullptr), syncEvent(*this)
+{
+    this->segment = new IOSegment("SERIAL", SBAddress, SCAddress + 1, this);
+    this->mmap.AddSegment(this->segment);
+
+    this->eventId = this->cpu.GetScheduler().Register(this);
+    this->syncEventId = this->cpu.GetScheduler().Register(&this->syncEvent);
+}
+
+Serial::~Serial()
+{
+    this->cpu.GetScheduler().Cancel(this->eventId);
+    this->cpu.GetScheduler().Cancel(this->syncEventId);
+    delete this->segment;
+}
+
+void Serial::SetLink(SerialLink *link)
+{
+    this->link = link;
+    this->outbox.clear();
+
+    if (link)
+        this->cpu.GetScheduler().Schedule(this->syncEventId, this->cpu.GetCycles() + SyncCycles);
+    else
+        this->cpu.GetScheduler().Cancel(this->syncEventId);
+}
+
+void Serial::SyncEvent::OnEvent(uint64_t deadline)
+{
+    if (this->serial.Sync())
+        this->serial.cpu.GetScheduler().Schedule(this->serial.syncEventId, deadline + SyncCycles);
+}
+
+bool Serial::Sync(void)
+{
+    if (!this->link)
+        return false;
+
+    this->outbox.push_back({ this->cpu.GetCycles(), SerialLink::MessageSync, 0 });
+    this->link->Send(this->outbox);
+    this->outbox.clear();
+
+    if (!this->link->Receive(this->inbox)) {
+        this->link = nullptr;
+        return false;
+    }
+
+    for (const SerialLink::Message& message : this->inbox) {
+        switch (message.type) {
+            case SerialLink::MessageStart:
+                /* Only a port waiting on the external clock takes part */
+                if (!this->IsTransferring() || this->IsInternalClock())
+                    break;
+
+                this->outbox.push_back({ message.cycles, SerialLink::MessageReply, this->sb });
+                this->incoming = message.byte;
+                this->transferStart = message.cycles;
+                this->cpu.GetScheduler().Schedule(this->eventId,
+                    std::max(message.cycles + TransferCycles, this->cpu.GetCycles()));
+                break;
+            case SerialLink::MessageReply:
+                if (this->IsTransferring() && this->IsInternalClock()
+                    && message.cycles == this->transferStart)
+                    this->incoming = message.byte;
+                break;
+            default:
+                break;
+        }
+    }
+
+    this->inbox.clear();
+    return true;
+}
+
+/* 8 kHz or 256 kHz, counted in CPU clocks so doubled in double speed */
+uint64_t Serial::GetTransferCycles(void) const
+{
+    uint64_t cycles = this->IsFastClock() ? FastTransferCycles : TransferCycles;
+    return this->cpu.IsDoubleSpeed() ? cycles / 2 : cycles;
+}
+
+uint8_t Serial::ReadRegister(uint16_t address)
+{
+    if (address == SBAddress)
+        return this->sb;
+    return this->sc | (this->color ? 0x7C : 0x7E);
+}
+
+void Serial::WriteRegister(uint16_t address, uint8_t byte)
+{
+    if (address == SBAddress) {
+        this->sb = byte;
+        return;
+    }
+
+    this->sc = byte & (this->color ? 0x83 : 0x81);
+    this->cpu.GetScheduler().Cancel(this->eventId);
+
+    if (!this->IsTransferring() || !this->IsInternalClock())
+        return;
+
+    uint64_t now = this->cpu.GetCycles();
+    this->incoming = 0xFF;
+    this->transferStart = now;
+    uint64_t cycles = this->link ? TransferCycles : this->GetTransferCycles();
+    this->cpu.GetScheduler().Schedule(this->eventId, now + cycles);
+
+    if (this->link)
+        this->outbox.push_back({ now, SerialLink::MessageStart, this->sb });
+}
+
+void Serial::OnEvent(uint64_t)
+{
+    this->output.push_back(this->sb);
+
+    this->sb = this->incoming;
+    this->incoming = 0xFF;
+    this->sc &= 0x7F;
+
+    this->interruptController.Request(InterruptController::InterruptSerial);
+}
+
+};
@@ -0,0 +1,153 @@
+#include <cstring>
+#include <stdexcept>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "SerialLink.hpp"
+
+namespace GameBoy
+{
+
+std::pair<std::unique_ptr<LocalSerialLink>, std::unique_ptr<LocalSerialLink>> LocalSerialLink::CreatePair(void)
+{
+    std::shared_ptr<Queue> a(new Queue()), b(new Queue());
+    a->closed = b->closed = false;
+
+    return std::make_pair(
+        std::unique_ptr<LocalSerialLink>(new LocalSerialLink(a, b)),
+        std::unique_ptr<LocalSerialLink>(new LocalSerialLink(b, a)));
+}
+
+LocalSerialLink::~LocalSerialLink()
+{
+    std::unique_lock<std::mutex> lock(this->outbox->mutex);
+    this->outbox->closed = true;
+    this->outbox->cv.notify_all();
+}
+
+void LocalSerialLink::Send(const std::vector<Message>& messages)
+{
+    std::unique_lock<std::mutex> lock(this->outbox->mutex);
+    this->outbox->messages.insert(this->outbox->messages.end(), messages.begin(), messages.end());
+    this->outbox->cv.notify_all();
+}
+
+bool LocalSerialLink::Receive(std::vector<Message>& messages)
+{
+    std::unique_lock<std::mutex> lock(this->inbox->mutex);
+
+    while (true) {
+        while (!this->inbox->messages.empty()) {
+            Message message = this->inbox->messages.front();
+            this->inbox->messages.pop_front();
+
+            if (message.type == MessageSync)
+                return true;
+            messages.push_back(message);
+        }
+
+        if (this->inbox->closed)
+            return false;
+        this->inbox->cv.wait(lock);
+    }
+}
+
+static struct sockaddr_un GetAddress(const std::string& path)
+{
+    struct sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path))
+        throw std::runtime_error("Socket path too long");
+    std::strcpy(address.sun_path, path.c_str());
+    return address;
+}
+
+std::unique_ptr<SocketSerialLink> SocketSerialLink::Listen(const std::string& path)
+{
+    struct sockaddr_un address = GetAddress(path);
+
+    int listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0)
+        throw std::runtime_error("Cannot create socket");
+
+    unlink(path.c_str());
+    if (bind(listenFd, (struct sockaddr*) &address, sizeof(address)) < 0 || listen(listenFd, 1) < 0) {
+        close(listenFd);
+        throw std::runtime_error("Cannot listen on Unix socket");
+    }
+
+    int fd = accept(listenFd, nullptr, nullptr);
+    close(listenFd);
+    unlink(path.c_str());
+    if (fd < 0)
+        throw std::runtime_error("Cannot accept link connection");
+
+    return std::unique_ptr<SocketSerialLink>(new SocketSerialLink(fd));
+}
+
+std::unique_ptr<SocketSerialLink> SocketSerialLink::Connect(const std::string& path)
+{
+    struct sockaddr_un address = GetAddress(path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+        throw std::runtime_error("Cannot create socket");
+
+    if (connect(fd, (struct sockaddr*) &address, sizeof(address)) < 0) {
+        close(fd);
+        throw std::runtime_error("Cannot connect to Unix socket");
+    }
+
+    return std::unique_ptr<SocketSerialLink>(new SocketSerialLink(fd));
+}
+
+SocketSerialLink::~SocketSerialLink()
+{
+    close(this->fd);
+}
+
+void SocketSerialLink::Send(const std::vector<Message>& messages)
+{
+    /* Both ends are on the same machine, messages go as they are */
+    const char *data = reinterpret_cast<const char*>(messages.data());
+    size_t size = messages.size() * sizeof(Message);
+
+    while (size > 0) {
+        ssize_t n = send(this->fd, data, size, MSG_NOSIGNAL);
+        if (n <= 0)
+            return;
+        data += n;
+        size -= n;
+    }
+}
+
+bool SocketSerialLink::Receive(std::vector<Message>& messages)
+{
+    size_t offset = 0;
+
+    while (true) {
+        /* Whole batches usually arrive in one read */
+        while (this->input.size() - offset >= sizeof(Message)) {
+            Message message;
+            std::memcpy(&message, this->input.data() + offset, sizeof(message));
+            offset += sizeof(message);
+
+            if (message.type == MessageSync) {
+                this->input.erase(0, offset);
+                return true;
+            }
+            messages.push_back(message);
+        }
+
+        char buffer[4096];
+        ssize_t n = recv(this->fd, buffer, sizeof(buffer), 0);
+        if (n <= 0)
+            return false;
+        this->input.append(buffer, n);
+    }
+}
+
+};
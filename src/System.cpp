@@ -0,0 +1,49 @@
+#include "System.hpp"
+
+namespace GameBoy
+{
+
+System::System(bool color, bool render, AudioRing *audio)
+: cpu(mmap), interruptController(mmap), video(mmap, cpu, interruptController, render),
+  dma(mmap, cpu), timer(mmap, cpu, interruptController),
+  serial(mmap, cpu, interruptController), joypad(mmap, cpu, interruptController),
+  wram(color ? new WorkRAM(mmap) : nullptr),
+  hdma(color ? new HDMA(mmap, cpu, video) : nullptr),
+  speedSwitch(color ? new SpeedSwitch(mmap, cpu, timer) : nullptr),
+  apu(mmap, cpu, audio)
+{
+    if (color) {
+        this->video.EnableColor();
+        this->serial.EnableColor();
+    }
+
+    this->cpu.SetInterruptController(&this->interruptController);
+}
+
+System::~System()
+{
+    if (this->blobSegment)
+        this->mmap.RemoveSegment(this->blobSegment.get());
+}
+
+std::vector<MemoryBanks*> System::GetMemoryBanks(void)
+{
+    std::vector<MemoryBanks*> banks = { &this->video.GetVRAMBanks() };
+    if (this->wram)
+        banks.push_back(&this->wram->GetMemoryBanks());
+    return banks;
+}
+
+void System::MapBlob(uint8_t *contents, uint32_t size)
+{
+    /* Nothing past the cartridge ROM window, VRAM and IO stay the devices' own */
+    this->blobSegment.reset(new MemorySegment(
+        "ROM", 0x0000, size < BlobEnd ? size : BlobEnd,
+        GameBoy::MemorySegment::Permissions::ReadWrite,
+        contents));
+
+    /* Searched first, ROM being what the CPU reads the most */
+    this->mmap.InsertSegment(this->blobSegment.get());
+}
+
+};
@@ -0,0 +1,154 @@
+#include "Timer.hpp"
+
+namespace GameBoy
+{
+
+Timer::Timer(MemoryMap& mmap, CPU& cpu, InterruptController& interruptController)
+: mmap(mmap), cpu(cpu), interruptController(interruptController),
+  divBase(0), timaBase(0), tima(0), tma(0), tac(0), speedShift(0)
+{
+    this->segment = new IOSegment("TIMER", DIVAddress, TACAddress + 1, this);
+    this->mmap.AddSegment(this->segment);
+
+    this->eventId = this->cpu.GetScheduler().Register(this);
+}
+
+Timer::~Timer()
+{
+    this->cpu.GetScheduler().Cancel(this->eventId);
+    delete this->segment;
+}
+
+void Timer::Increment(uint64_t n)
+{
+    uint64_t value = this->tima + n;
+
+    /* Overflows reload TMA and request an interrupt */
+    while (value > 0xff) {
+        value = this->tma + (value - 0x100);
+        this->interruptController.Request(InterruptController::InterruptTimer);
+    }
+
+    this->tima = value;
+}
+
+void Timer::Sync(uint64_t now)
+{
+    if (now <= this->timaBase)
+        return;
+
+    if (this->IsEnabled()) {
+        uint8_t shift = this->GetPeriodShift();
+        uint64_t edges = (this->GetDivider(now) >> shift)
+                       - (this->GetDivider(this->timaBase) >> shift);
+        this->Increment(edges);
+    }
+
+    this->timaBase = now;
+}
+
+void Timer::ScheduleOverflow(void)
+{
+    Scheduler& scheduler = this->cpu.GetScheduler();
+
+    if (!this->IsEnabled()) {
+        scheduler.Cancel(this->eventId);
+        return;
+    }
+
+    /* Cycle of the edge bringing TIMA from its current value to 0x100 */
+    uint8_t shift = this->GetPeriodShift();
+    uint64_t edges = this->GetDivider(this->timaBase) >> shift;
+    uint64_t deadline = this->divBase + (((edges + 0x100 - this->tima) << shift) >> this->speedShift);
+
+    scheduler.Schedule(this->eventId, deadline);
+}
+
+void Timer::SetDoubleSpeed(bool doubleSpeed)
+{
+    uint64_t now = this->cpu.GetCycles();
+    this->Sync(now);
+
+    if (this->IsEnabled() && this->IsSelectedBitSet(now))
+        this->Increment(1);
+
+    this->speedShift = doubleSpeed ? 1 : 0;
+    this->divBase = now;
+    this->ScheduleOverflow();
+}
+
+void Timer::SetDivider(uint16_t divider)
+{
+    uint64_t now = this->cpu.GetCycles();
+    this->Sync(now);
+
+    /* May wrap below zero, only differences with divBase are used */
+    this->divBase = now - (divider >> this->speedShift);
+    this->timaBase = now;
+    this->ScheduleOverflow();
+}
+
+uint8_t Timer::ReadRegister(uint16_t address)
+{
+    uint64_t now = this->cpu.GetCycles();
+
+    switch (address) {
+        case DIVAddress:
+            return (this->GetDivider(now) >> 8) & 0xff;
+        case TIMAAddress:
+            this->Sync(now);
+            return this->tima;
+        case TMAAddress:
+            return this->tma;
+        case TACAddress:
+            return this->tac | 0xf8;
+        default:
+            break;
+    }
+
+    return 0xff;
+}
+
+void Timer::WriteRegister(uint16_t address, uint8_t byte)
+{
+    uint64_t now = this->cpu.GetCycles();
+    this->Sync(now);
+
+    switch (address) {
+        case DIVAddress:
+            /* Resetting the divider while the selected bit is set is an edge */
+            if (this->IsEnabled() && this->IsSelectedBitSet(now))
+                this->Increment(1);
+            this->divBase = now;
+            break;
+        case TIMAAddress:
+            this->tima = byte;
+            break;
+        case TMAAddress:
+            this->tma = byte;
+            break;
+        case TACAddress: {
+            bool wasHigh = this->IsEnabled() && this->IsSelectedBitSet(now);
+            this->tac = byte & 0x07;
+            bool isHigh = this->IsEnabled() && this->IsSelectedBitSet(now);
+
+            /* DMG quirk: the multiplexer output falling also ticks TIMA */
+            if (wasHigh && !isHigh)
+                this->Increment(1);
+            break;
+        }
+        default:
+            break;
+    }
+
+    this->timaBase = now;
+    this->ScheduleOverflow();
+}
+
+void Timer::OnEvent(uint64_t deadline)
+{
+    this->Sync(deadline);
+    this->ScheduleOverflow();
+}
+
+};
@@ -0,0 +1,622 @@
+#include <algorithm>
+#include <cstring>
+
+#include "Video.hpp"
+
+namespace GameBoy
+{
+
+static const uint32_t Shades[] = { 0xFFFFFFFF, 0xFFAAAAAA, 0xFF555555, 0xFF000000 };
+
+static const uint8_t StatHBlank = 0x08;
+static const uint8_t StatVBlank = 0x10;
+static const uint8_t StatOAM    = 0x20;
+static const uint8_t StatLYC    = 0x40;
+
+/* Where palette writes are logged, past the VRAM and OAM addresses */
+static const uint16_t BGPaletteLog  = 0xFF00;
+static const uint16_t OBJPaletteLog = 0xFF40;
+
+static inline uint32_t GetShade(uint8_t palette, uint8_t color)
+{
+    return Shades[(palette >> (color * 2)) & 0x03];
+}
+
+/* CGB palettes hold four little-endian RGB555 colors each */
+static inline uint32_t GetColor(const uint8_t *palettes, uint8_t palette, uint8_t color)
+{
+    const uint8_t *entry = palettes + palette * 8 + color * 2;
+    uint16_t rgb = entry[0] | (entry[1] << 8);
+
+    uint32_t r = rgb & 0x1F, g = (rgb >> 5) & 0x1F, b = (rgb >> 10) & 0x1F;
+    r = (r << 3) | (r >> 2);
+    g = (g << 3) | (g >> 2);
+    b = (b << 3) | (b >> 2);
+    return 0xFF000000 | (r << 16) | (g << 8) | b;
+}
+
+void VideoMemorySegment::Write(uint16_t address, const uint8_t *bytes, uint16_t size)
+{
+    MemorySegment::Write(address, bytes, size);
+    for (uint16_t i = 0; i < size; i++)
+        this->video.OnMemoryWrite(address + i, bytes[i]);
+}
+
+void VideoMemorySegment::WriteByte(uint16_t address, const uint8_t byte)
+{
+    MemorySegment::WriteByte(address, byte);
+    this->video.OnMemoryWrite(address, byte);
+}
+
+Video::Video(MemoryMap& mmap, CPU& cpu, InterruptController& interruptController, bool render)
+: mmap(mmap), cpu(cpu), interruptController(interruptController),
+  stat(0), lyc(0), color(false), vbk(0), bcps(0), ocps(0), hblankListener(nullptr),
+  lcdStart(0), hblankNext(false), render(render),
+  filling(&records[0]), rendering(nullptr), closing(false), back(0), nFrames(0), sink(nullptr)
+{
+    std::memset(&this->state, 0, sizeof(this->state));
+    std::memset(this->bgPalettes, 0xFF, sizeof(this->bgPalettes));
+    std::memset(this->objPalettes, 0xFF, sizeof(this->objPalettes));
+
+    /* Bank 1 is only reachable in CGB mode */
+    this->vram = new uint8_t [2 * VRAMBankSize]();
+    this->vramBanks = new MemoryBanks(mmap, this->vram, 0x8000, VRAMBankSize, 2);
+    this->oam = new uint8_t [0xA0]();
+
+    /* Writes only need to be seen when something renders them */
+    if (this->render) {
+        this->vramSegment = new VideoMemorySegment("VRAM", 0x8000, 0xA000, this->vram, *this);
+        this->oamSegment = new VideoMemorySegment("OAM", 0xFE00, 0xFEA0, this->oam, *this);
+    } else {
+        this->vramSegment = new MemorySegment(
+            "VRAM", 0x8000, 0xA000,
+            GameBoy::MemorySegment::Permissions::ReadWrite,
+            this->vram
+        );
+        this->oamSegment = new MemorySegment(
+            "OAM", 0xFE00, 0xFEA0,
+            GameBoy::MemorySegment::Permissions::ReadWrite,
+            this->oam
+        );
+    }
+
+    this->lcdSegment = new IOSegment("LCD", LCDCAddress, LYCAddress + 1, this);
+    this->paletteSegment = new IOSegment("LCD", BGPAddress, WXAddress + 1, this);
+    this->vbkSegment = new IOSegment("VBK", VBKAddress, VBKAddress + 1, this);
+    this->colorPaletteSegment = new IOSegment("LCD", BCPSAddress, OCPDAddress + 1, this);
+
+    this->mmap.AddSegment(this->vramSegment);
+    this->mmap.AddSegment(this->oamSegment);
+    this->mmap.AddSegment(this->lcdSegment);
+    this->mmap.AddSegment(this->paletteSegment);
+
+    this->eventId = this->cpu.GetScheduler().Register(this);
+
+    if (this->render) {
+        for (FrameRecord& record : this->records) {
+            record.reload = false;
+            record.nLines = 0;
+        }
+
+        this->shadowVram.resize(2 * VRAMBankSize);
+        this->shadowOam.resize(0xA0);
+        std::memcpy(this->shadowBgPalettes, this->bgPalettes, PaletteSize);
+        std::memcpy(this->shadowObjPalettes, this->objPalettes, PaletteSize);
+        this->framebuffers[0].resize(Width * Height, Shades[0]);
+        this->framebuffers[1].resize(Width * Height, Shades[0]);
+
+        this->worker = std::thread(&Video::Work, this);
+    }
+}
+
+Video::~Video()
+{
+    if (this->render) {
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->closing = true;
+            this->cv.notify_all();
+        }
+        this->worker.join();
+    }
+
+    this->cpu.GetScheduler().Cancel(this->eventId);
+
+    delete this->colorPaletteSegment;
+    delete this->vbkSegment;
+    delete this->paletteSegment;
+    delete this->lcdSegment;
+    delete this->oamSegment;
+    delete [] this->oam;
+    delete this->vramSegment;
+    delete this->vramBanks;
+    delete [] this->vram;
+}
+
+uint8_t Video::GetMode(uint64_t now) const
+{
+    if (!this->IsLCDOn())
+        return 0;
+
+    if (this->GetLine(now) >= Height)
+        return 1;
+
+    uint64_t cycle = (now - this->lcdStart) % LineCycles;
+    if (cycle < 80)
+        return 2;
+    return (cycle < HBlankCycle) ? 3 : 0;
+}
+
+void Video::RequestStat(uint8_t source)
+{
+    if (this->stat & source)
+        this->interruptController.Request(InterruptController::InterruptLCDStat);
+}
+
+void Video::TurnOn(uint64_t now)
+{
+    this->lcdStart = now;
+    this->hblankNext = false;
+    this->cpu.GetScheduler().Schedule(this->eventId, now);
+
+    /* VRAM writes went unlogged while the LCD was off */
+    if (this->render) {
+        this->filling->reload = true;
+        this->filling->vram.assign(this->vram, this->vram + 2 * VRAMBankSize);
+        this->filling->oam.assign(this->oam, this->oam + 0xA0);
+        std::memcpy(this->filling->bgPalettes, this->bgPalettes, PaletteSize);
+        std::memcpy(this->filling->objPalettes, this->objPalettes, PaletteSize);
+        this->filling->nLines = 0;
+        this->filling->writes.clear();
+    }
+}
+
+void Video::TurnOff(void)
+{
+    this->cpu.GetScheduler().Cancel(this->eventId);
+
+    if (this->render) {
+        this->filling->nLines = 0;
+        this->filling->writes.clear();
+    }
+}
+
+void Video::Submit(void)
+{
+    std::unique_lock<std::mutex> lock(this->mutex);
+
+    /* The other record is free once the previous frame is composed */
+    this->cv.wait(lock, [this] { return this->rendering == nullptr; });
+
+    this->rendering = this->filling;
+    this->filling = (this->filling == &this->records[0]) ? &this->records[1] : &this->records[0];
+    this->filling->reload = false;
+    this->filling->nLines = 0;
+    this->filling->writes.clear();
+
+    this->cv.notify_all();
+}
+
+void Video::Finish(void)
+{
+    if (!this->render)
+        return;
+
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->cv.wait(lock, [this] { return this->rendering == nullptr; });
+}
+
+void Video::EnableColor(void)
+{
+    this->color = true;
+    this->mmap.AddSegment(this->vbkSegment);
+    this->mmap.AddSegment(this->colorPaletteSegment);
+}
+
+void Video::OnMemoryWrite(uint16_t address, uint8_t byte)
+{
+    if (address < 0xA000 && this->vbk)
+        address += VRAMBankSize;
+
+    if (this->IsLCDOn())
+        this->filling->writes.push_back({ address, byte, static_cast<uint8_t>(this->filling->nLines) });
+}
+
+void Video::WritePalette(uint8_t& index, uint8_t *palettes, uint16_t logBase, uint8_t byte)
+{
+    uint8_t offset = index & 0x3F;
+    palettes[offset] = byte;
+
+    if (this->render)
+        this->OnMemoryWrite(logBase + offset, byte);
+
+    /* Auto-increment wraps within the 64 bytes */
+    if (index & 0x80)
+        index = 0x80 | ((offset + 1) & 0x3F);
+}
+
+void Video::Work(void)
+{
+    while (true) {
+        const FrameRecord *record;
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->cv.wait(lock, [this] { return this->closing || this->rendering; });
+            if (!this->rendering)
+                return;
+            record = this->rendering;
+        }
+
+        this->Compose(*record);
+
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->rendering = nullptr;
+            this->cv.notify_all();
+        }
+    }
+}
+
+void Video::Compose(const FrameRecord& record)
+{
+    if (record.reload) {
+        std::copy(record.vram.begin(), record.vram.end(), this->shadowVram.begin());
+        std::copy(record.oam.begin(), record.oam.end(), this->shadowOam.begin());
+        std::memcpy(this->shadowBgPalettes, record.bgPalettes, PaletteSize);
+        std::memcpy(this->shadowObjPalettes, record.objPalettes, PaletteSize);
+    }
+
+    uint32_t *pixels = this->framebuffers[this->back].data();
+    size_t w = 0;
+    int windowLine = 0;
+
+    for (int y = 0; y <= record.nLines; y++) {
+        for (; w < record.writes.size() && record.writes[w].line <= y; w++) {
+            const MemoryWrite& write = record.writes[w];
+            if (write.address < 0xC000)
+                this->shadowVram[write.address - 0x8000] = write.byte;
+            else if (write.address < BGPaletteLog)
+                this->shadowOam[write.address - 0xFE00] = write.byte;
+            else if (write.address < OBJPaletteLog)
+                this->shadowBgPalettes[write.address - BGPaletteLog] = write.byte;
+            else
+                this->shadowObjPalettes[write.address - OBJPaletteLog] = write.byte;
+        }
+
+        if (y < record.nLines && this->color)
+            this->RenderColorLine(record.lines[y], y, windowLine, pixels + y * Width);
+        else if (y < record.nLines)
+            this->RenderLine(record.lines[y], y, windowLine, pixels + y * Width);
+    }
+
+    if (this->sink)
+        this->sink->OnFrame(pixels, this->nFrames);
+
+    this->nFrames++;
+    this->back ^= 1;
+}
+
+uint8_t Video::GetTilePixel(uint16_t map, uint8_t x, uint8_t y, uint8_t lcdc) const
+{
+    uint8_t tile = this->shadowVram[map + (y / 8) * 32 + x / 8];
+
+    /* 0x8000 unsigned or 0x9000 signed tile addressing */
+    uint16_t address = (lcdc & 0x10) ? tile * 16 : 0x1000 + static_cast<int8_t>(tile) * 16;
+    address += (y % 8) * 2;
+
+    int bit = 7 - x % 8;
+    return (((this->shadowVram[address + 1] >> bit) & 1) << 1)
+         | ((this->shadowVram[address] >> bit) & 1);
+}
+
+void Video::RenderLine(const LineState& line, int y, int& windowLine, uint32_t *row) const
+{
+    uint8_t colors[Width];
+    std::memset(colors, 0, sizeof(colors));
+
+    if (line.lcdc & 0x01) {
+        uint16_t bgMap = (line.lcdc & 0x08) ? 0x1C00 : 0x1800;
+        for (int x = 0; x < Width; x++)
+            colors[x] = this->GetTilePixel(bgMap, x + line.scx, y + line.scy, line.lcdc);
+
+        if ((line.lcdc & 0x20) && y >= line.wy && line.wx <= 166) {
+            uint16_t windowMap = (line.lcdc & 0x40) ? 0x1C00 : 0x1800;
+            int start = line.wx - 7;
+            for (int x = std::max(start, 0); x < Width; x++)
+                colors[x] = this->GetTilePixel(windowMap, x - start, windowLine, line.lcdc);
+            windowLine++;
+        }
+    }
+
+    for (int x = 0; x < Width; x++)
+        row[x] = GetShade(line.bgp, colors[x]);
+
+    if (!(line.lcdc & 0x02))
+        return;
+
+    /* First ten sprites on the line in OAM order, lower X drawn last */
+    int height = (line.lcdc & 0x04) ? 16 : 8;
+    int sprites[10];
+    int nSprites = 0;
+
+    for (int i = 0; i < 40 && nSprites < 10; i++) {
+        int top = this->shadowOam[i * 4] - 16;
+        if (y >= top && y < top + height)
+            sprites[nSprites++] = i;
+    }
+
+    std::stable_sort(sprites, sprites + nSprites, [this](int a, int b) {
+        return this->shadowOam[a * 4 + 1] < this->shadowOam[b * 4 + 1];
+    });
+
+    for (int s = nSprites - 1; s >= 0; s--) {
+        const uint8_t *sprite = &this->shadowOam[sprites[s] * 4];
+        uint8_t attributes = sprite[3];
+        uint8_t palette = (attributes & 0x10) ? line.obp1 : line.obp0;
+
+        int spriteRow = y - (sprite[0] - 16);
+        if (attributes & 0x40)
+            spriteRow = height - 1 - spriteRow;
+
+        uint8_t tile = (height == 16) ? (sprite[2] & 0xFE) : sprite[2];
+        uint16_t address = tile * 16 + spriteRow * 2;
+        uint8_t low = this->shadowVram[address];
+        uint8_t high = this->shadowVram[address + 1];
+
+        for (int px = 0; px < 8; px++) {
+            int x = sprite[1] - 8 + px;
+            if (x < 0 || x >= Width)
+                continue;
+
+            int bit = (attributes & 0x20) ? px : 7 - px;
+            uint8_t color = (((high >> bit) & 1) << 1) | ((low >> bit) & 1);
+
+            /* Color 0 is transparent, BG colors 1-3 cover sprites behind them */
+            if (!color || ((attributes & 0x80) && colors[x]))
+                continue;
+
+            row[x] = GetShade(palette, color);
+        }
+    }
+}
+
+uint8_t Video::GetColorTilePixel(uint16_t map, uint8_t x, uint8_t y, uint8_t lcdc, uint8_t& attributes) const
+{
+    uint16_t index = map + (y / 8) * 32 + x / 8;
+    uint8_t tile = this->shadowVram[index];
+    attributes = this->shadowVram[VRAMBankSize + index];
+
+    uint16_t address = (lcdc & 0x10) ? tile * 16 : 0x1000 + static_cast<int8_t>(tile) * 16;
+    if (attributes & 0x08)
+        address += VRAMBankSize;
+
+    uint8_t row = (attributes & 0x40) ? 7 - y % 8 : y % 8;
+    address += row * 2;
+
+    int bit = (attributes & 0x20) ? x % 8 : 7 - x % 8;
+    return (((this->shadowVram[address + 1] >> bit) & 1) << 1)
+         | ((this->shadowVram[address] >> bit) & 1);
+}
+
+void Video::RenderColorLine(const LineState& line, int y, int& windowLine, uint32_t *row) const
+{
+    uint8_t colors[Width];
+    /* Tiles with bit 7 set cover sprites with their colors 1-3 */
+    bool priority[Width];
+    uint8_t attributes;
+
+    /* LCDC bit 0 no longer hides the background, only its priority */
+    uint16_t bgMap = (line.lcdc & 0x08) ? 0x1C00 : 0x1800;
+    for (int x = 0; x < Width; x++) {
+        colors[x] = this->GetColorTilePixel(bgMap, x + line.scx, y + line.scy, line.lcdc, attributes);
+        priority[x] = attributes & 0x80;
+        row[x] = GetColor(this->shadowBgPalettes, attributes & 0x07, colors[x]);
+    }
+
+    if ((line.lcdc & 0x20) && y >= line.wy && line.wx <= 166) {
+        uint16_t windowMap = (line.lcdc & 0x40) ? 0x1C00 : 0x1800;
+        int start = line.wx - 7;
+        for (int x = std::max(start, 0); x < Width; x++) {
+            colors[x] = this->GetColorTilePixel(windowMap, x - start, windowLine, line.lcdc, attributes);
+            priority[x] = attributes & 0x80;
+            row[x] = GetColor(this->shadowBgPalettes, attributes & 0x07, colors[x]);
+        }
+        windowLine++;
+    }
+
+    if (!(line.lcdc & 0x02))
+        return;
+
+    /* First ten sprites on the line, lower OAM index drawn last */
+    int height = (line.lcdc & 0x04) ? 16 : 8;
+    int sprites[10];
+    int nSprites = 0;
+
+    for (int i = 0; i < 40 && nSprites < 10; i++) {
+        int top = this->shadowOam[i * 4] - 16;
+        if (y >= top && y < top + height)
+            sprites[nSprites++] = i;
+    }
+
+    for (int s = nSprites - 1; s >= 0; s--) {
+        const uint8_t *sprite = &this->shadowOam[sprites[s] * 4];
+        uint8_t spriteAttributes = sprite[3];
+
+        int spriteRow = y - (sprite[0] - 16);
+        if (spriteAttributes & 0x40)
+            spriteRow = height - 1 - spriteRow;
+
+        uint8_t tile = (height == 16) ? (sprite[2] & 0xFE) : sprite[2];
+        uint16_t address = tile * 16 + spriteRow * 2;
+        if (spriteAttributes & 0x08)
+            address += VRAMBankSize;
+        uint8_t low = this->shadowVram[address];
+        uint8_t high = this->shadowVram[address + 1];
+
+        for (int px = 0; px < 8; px++) {
+            int x = sprite[1] - 8 + px;
+            if (x < 0 || x >= Width)
+                continue;
+
+            int bit = (spriteAttributes & 0x20) ? px : 7 - px;
+            uint8_t color = (((high >> bit) & 1) << 1) | ((low >> bit) & 1);
+            if (!color)
+                continue;
+
+            if ((line.lcdc & 0x01) && colors[x] && (priority[x] || (spriteAttributes & 0x80)))
+                continue;
+
+            row[x] = GetColor(this->shadowObjPalettes, spriteAttributes & 0x07, color);
+        }
+    }
+}
+
+uint8_t Video::ReadRegister(uint16_t address)
+{
+    uint64_t now = this->cpu.GetCycles();
+
+    switch (address) {
+        case LCDCAddress:
+            return this->state.lcdc;
+        case STATAddress: {
+            uint8_t ly = this->IsLCDOn() ? this->GetLine(now) : 0;
+            uint8_t coincidence = (ly == this->lyc) ? 0x04 : 0;
+            return 0x80 | (this->stat & 0x78) | coincidence | this->GetMode(now);
+        }
+        case SCYAddress:
+            return this->state.scy;
+        case SCXAddress:
+            return this->state.scx;
+        case LYAddress:
+            return this->IsLCDOn() ? this->GetLine(now) : 0;
+        case LYCAddress:
+            return this->lyc;
+        case BGPAddress:
+            return this->state.bgp;
+        case OBP0Address:
+            return this->state.obp0;
+        case OBP1Address:
+            return this->state.obp1;
+        case WYAddress:
+            return this->state.wy;
+        case WXAddress:
+            return this->state.wx;
+        case VBKAddress:
+            return 0xFE | this->vbk;
+        case BCPSAddress:
+            return 0x40 | this->bcps;
+        case BCPDAddress:
+            return this->bgPalettes[this->bcps & 0x3F];
+        case OCPSAddress:
+            return 0x40 | this->ocps;
+        case OCPDAddress:
+            return this->objPalettes[this->ocps & 0x3F];
+        default:
+            break;
+    }
+
+    return 0xFF;
+}
+
+void Video::WriteRegister(uint16_t address, uint8_t byte)
+{
+    switch (address) {
+        case LCDCAddress: {
+            bool wasOn = this->IsLCDOn();
+            this->state.lcdc = byte;
+
+            if (!wasOn && this->IsLCDOn())
+                this->TurnOn(this->cpu.GetCycles());
+            else if (wasOn && !this->IsLCDOn())
+                this->TurnOff();
+            break;
+        }
+        case STATAddress:
+            this->stat = byte & 0x78;
+            break;
+        case SCYAddress:
+            this->state.scy = byte;
+            break;
+        case SCXAddress:
+            this->state.scx = byte;
+            break;
+        case LYCAddress:
+            this->lyc = byte;
+            break;
+        case BGPAddress:
+            this->state.bgp = byte;
+            break;
+        case OBP0Address:
+            this->state.obp0 = byte;
+            break;
+        case OBP1Address:
+            this->state.obp1 = byte;
+            break;
+        case WYAddress:
+            this->state.wy = byte;
+            break;
+        case WXAddress:
+            this->state.wx = byte;
+            break;
+        case VBKAddress:
+            this->vbk = byte & 0x01;
+            this->vramSegment->SetMemory(this->vram + this->vbk * VRAMBankSize);
+            this->vramBanks->Switch(this->vbk);
+            break;
+        case BCPSAddress:
+            this->bcps = byte & 0xBF;
+            break;
+        case BCPDAddress:
+            this->WritePalette(this->bcps, this->bgPalettes, BGPaletteLog, byte);
+            break;
+        case OCPSAddress:
+            this->ocps = byte & 0xBF;
+            break;
+        case OCPDAddress:
+            this->WritePalette(this->ocps, this->objPalettes, OBJPaletteLog, byte);
+            break;
+        default:
+            break;
+    }
+}
+
+void Video::OnEvent(uint64_t deadline)
+{
+    Scheduler& scheduler = this->cpu.GetScheduler();
+    uint64_t line = this->GetLine(deadline);
+    uint64_t lineStart = deadline - (deadline - this->lcdStart) % LineCycles;
+
+    if (this->hblankNext) {
+        /* Registers as they were when the line was drawn */
+        if (this->render && this->filling->nLines < Height)
+            this->filling->lines[this->filling->nLines++] = this->state;
+
+        this->RequestStat(StatHBlank);
+        if (this->hblankListener)
+            this->hblankListener->OnHBlank(deadline);
+        this->hblankNext = false;
+        scheduler.Schedule(this->eventId, lineStart + LineCycles);
+        return;
+    }
+
+    if (line == this->lyc)
+        this->RequestStat(StatLYC);
+
+    if (line < Height) {
+        this->RequestStat(StatOAM);
+        this->hblankNext = true;
+        scheduler.Schedule(this->eventId, lineStart + HBlankCycle);
+        return;
+    }
+
+    if (line == Height) {
+        this->interruptController.Request(InterruptController::InterruptVBlank);
+        this->RequestStat(StatVBlank);
+        if (this->render)
+            this->Submit();
+    }
+
+    scheduler.Schedule(this->eventId, lineStart + LineCycles);
+}
+
+};
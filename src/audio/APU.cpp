@@ -0,0 +1,520 @@
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#include "audio/APU.hpp"
+
+namespace GameBoy
+{
+
+/* Bits reading back as 1 in NR10-0xFF2F, write-only and unused bits */
+static const uint8_t ReadMasks[] = {
+    0x80, 0x3F, 0x00, 0xFF, 0xBF,   /* NR10-NR14 */
+    0xFF, 0x3F, 0x00, 0xFF, 0xBF,   /* NR20-NR24 */
+    0x7F, 0xFF, 0x9F, 0xFF, 0xBF,   /* NR30-NR34 */
+    0xFF, 0xFF, 0x00, 0x00, 0xBF,   /* NR40-NR44 */
+    0x00, 0x00, 0x70,               /* NR50-NR52 */
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+};
+
+static const uint8_t DutyPatterns[] = { 0x01, 0x81, 0x87, 0x7E };
+static const uint8_t NoiseDivisors[] = { 8, 16, 32, 48, 64, 80, 96, 112 };
+
+APUCore::APUCore(AudioRing *output, uint32_t sampleRate, uint64_t now)
+: output(output),
+  buffers{ { ClockRate, sampleRate, sampleRate / 64 }, { ClockRate, sampleRate, sampleRate / 64 } },
+  powered(false), sequencerStep(0), sweepTimer(0), sweepShadow(0), sweepEnabled(false),
+  lastSync(now), frameStart(now), nextStep(now + SequencerCycles)
+{
+    std::memset(this->registers, 0, sizeof(this->registers));
+    std::memset(this->channels, 0, sizeof(this->channels));
+
+    for (int n = 0; n < 4; n++)
+        this->UpdatePeriod(n);
+}
+
+uint16_t APUCore::GetFrequency(int n)
+{
+    return this->GetChannelRegister(n, 3) | ((this->GetChannelRegister(n, 4) & 0x07) << 8);
+}
+
+void APUCore::UpdatePeriod(int n)
+{
+    Channel& channel = this->channels[n];
+
+    if (n < 2) {
+        channel.period = (2048 - this->GetFrequency(n)) * 4;
+    } else if (n == 2) {
+        channel.period = (2048 - this->GetFrequency(n)) * 2;
+    } else {
+        /* Shifts of 14 and 15 stop the LFSR */
+        uint8_t nr43 = this->GetChannelRegister(3, 3);
+        uint8_t shift = nr43 >> 4;
+        channel.period = (shift < 14) ? NoiseDivisors[nr43 & 0x07] << shift : 0;
+    }
+}
+
+/* Digital output of the channel, 0-15 */
+uint8_t APUCore::GetLevel(int n)
+{
+    const Channel& channel = this->channels[n];
+
+    if (!channel.enabled || !channel.dacEnabled)
+        return 0;
+
+    switch (n) {
+        case 0:
+        case 1: {
+            uint8_t duty = this->GetChannelRegister(n, 1) >> 6;
+            return ((DutyPatterns[duty] >> channel.position) & 1) ? channel.volume : 0;
+        }
+        case 2: {
+            static const uint8_t shifts[] = { 4, 0, 1, 2 };
+            uint8_t byte = this->GetRegister(WaveRAMAddress + channel.position / 2);
+            uint8_t sample = (channel.position & 1) ? (byte & 0x0F) : (byte >> 4);
+            return sample >> shifts[(this->GetChannelRegister(2, 2) >> 5) & 0x03];
+        }
+        default:
+            return (channel.lfsr & 1) ? 0 : channel.volume;
+    }
+}
+
+void APUCore::UpdateAmplitude(int n, uint64_t time)
+{
+    Channel& channel = this->channels[n];
+    uint8_t level = this->GetLevel(n);
+    uint8_t nr50 = this->GetRegister(NR50Address);
+    uint8_t nr51 = this->GetRegister(NR51Address);
+
+    /* Left is the upper nibble of NR50 and NR51 */
+    for (int side = 0; side < 2; side++) {
+        int shift = side ? 0 : 4;
+        int32_t amplitude = 0;
+        if (nr51 & (1 << (n + shift)))
+            amplitude = level * (((nr50 >> shift) & 0x07) + 1) * AmplitudeScale;
+
+        if (amplitude != channel.amplitude[side]) {
+            this->buffers[side].AddDelta(time - this->frameStart, amplitude - channel.amplitude[side]);
+            channel.amplitude[side] = amplitude;
+        }
+    }
+}
+
+void APUCore::UpdateAmplitudes(uint64_t time)
+{
+    if (!this->output)
+        return;
+
+    for (int n = 0; n < 4; n++)
+        this->UpdateAmplitude(n, time);
+}
+
+void APUCore::StepWaveform(int n)
+{
+    Channel& channel = this->channels[n];
+
+    if (n < 2) {
+        channel.position = (channel.position + 1) & 7;
+    } else if (n == 2) {
+        channel.position = (channel.position + 1) & 31;
+    } else {
+        uint16_t bit = (channel.lfsr ^ (channel.lfsr >> 1)) & 1;
+        channel.lfsr = (channel.lfsr >> 1) | (bit << 14);
+
+        /* 7-bit mode also feeds bit 6 */
+        if (this->GetChannelRegister(3, 3) & 0x08)
+            channel.lfsr = (channel.lfsr & ~0x40) | (bit << 6);
+    }
+}
+
+void APUCore::RunChannel(int n, uint64_t now)
+{
+    Channel& channel = this->channels[n];
+
+    if (!channel.period || channel.nextEdge > now)
+        return;
+
+    /* Silent channels only need their phase kept, skip all edges at once */
+    if (!channel.enabled) {
+        uint64_t steps = (now - channel.nextEdge) / channel.period + 1;
+        if (n < 3)
+            channel.position = (channel.position + steps) & ((n == 2) ? 31 : 7);
+        channel.nextEdge += steps * channel.period;
+        return;
+    }
+
+    while (channel.nextEdge <= now) {
+        this->StepWaveform(n);
+        this->UpdateAmplitude(n, channel.nextEdge);
+        channel.nextEdge += channel.period;
+    }
+}
+
+void APUCore::Sync(uint64_t now)
+{
+    if (now <= this->lastSync)
+        return;
+
+    if (this->output) {
+        for (int n = 0; n < 4; n++)
+            this->RunChannel(n, now);
+    }
+
+    this->lastSync = now;
+}
+
+void APUCore::Trigger(int n, uint64_t now)
+{
+    Channel& channel = this->channels[n];
+
+    channel.enabled = channel.dacEnabled;
+    if (channel.length == 0)
+        channel.length = (n == 2) ? 256 : 64;
+    channel.nextEdge = now + channel.period;
+
+    if (n != 2) {
+        uint8_t envelope = this->GetChannelRegister(n, 2);
+        channel.volume = envelope >> 4;
+        channel.envelopeTimer = envelope & 0x07;
+    }
+
+    if (n == 2)
+        channel.position = 0;
+    if (n == 3)
+        channel.lfsr = 0x7FFF;
+
+    if (n == 0) {
+        uint8_t nr10 = this->GetChannelRegister(0, 0);
+        uint8_t period = (nr10 >> 4) & 0x07;
+
+        this->sweepShadow = this->GetFrequency(0);
+        this->sweepTimer = period ? period : 8;
+        this->sweepEnabled = period || (nr10 & 0x07);
+
+        /* Overflow check right away when shifting */
+        if (nr10 & 0x07)
+            this->CalculateSweep();
+    }
+}
+
+uint16_t APUCore::CalculateSweep(void)
+{
+    uint8_t nr10 = this->GetChannelRegister(0, 0);
+    uint16_t delta = this->sweepShadow >> (nr10 & 0x07);
+    uint16_t frequency = (nr10 & 0x08) ? this->sweepShadow - delta : this->sweepShadow + delta;
+
+    if (frequency > 2047)
+        this->channels[0].enabled = false;
+    return frequency;
+}
+
+void APUCore::ClockLength(void)
+{
+    for (Channel& channel : this->channels) {
+        if (channel.lengthEnabled && channel.length && --channel.length == 0)
+            channel.enabled = false;
+    }
+}
+
+void APUCore::ClockSweep(void)
+{
+    if (this->sweepTimer && --this->sweepTimer)
+        return;
+
+    uint8_t nr10 = this->GetChannelRegister(0, 0);
+    uint8_t period = (nr10 >> 4) & 0x07;
+    this->sweepTimer = period ? period : 8;
+
+    if (!this->sweepEnabled || !period)
+        return;
+
+    uint16_t frequency = this->CalculateSweep();
+    if (frequency > 2047 || !(nr10 & 0x07))
+        return;
+
+    this->sweepShadow = frequency;
+    this->GetChannelRegister(0, 3) = frequency & 0xFF;
+    this->GetChannelRegister(0, 4) = (this->GetChannelRegister(0, 4) & ~0x07) | (frequency >> 8);
+    this->UpdatePeriod(0);
+
+    this->CalculateSweep();
+}
+
+void APUCore::ClockEnvelope(void)
+{
+    for (int n : { 0, 1, 3 }) {
+        Channel& channel = this->channels[n];
+        uint8_t envelope = this->GetChannelRegister(n, 2);
+        uint8_t period = envelope & 0x07;
+
+        if (!period || (channel.envelopeTimer && --channel.envelopeTimer))
+            continue;
+
+        channel.envelopeTimer = period;
+        if ((envelope & 0x08) && channel.volume < 15)
+            channel.volume++;
+        else if (!(envelope & 0x08) && channel.volume > 0)
+            channel.volume--;
+    }
+}
+
+void APUCore::PowerOff(void)
+{
+    /* Everything but NR52 and wave RAM is cleared, length counters survive */
+    std::memset(this->registers, 0, NR52Address - NR10Address);
+
+    for (int n = 0; n < 4; n++) {
+        Channel& channel = this->channels[n];
+        channel.enabled = false;
+        channel.dacEnabled = false;
+        channel.lengthEnabled = false;
+        this->UpdatePeriod(n);
+    }
+
+    this->sweepEnabled = false;
+    this->powered = false;
+}
+
+void APUCore::Flush(void)
+{
+    size_t count = this->buffers[0].GetSamplesAvailable();
+
+    for (int side = 0; side < 2; side++) {
+        this->scratch[side].resize(count);
+        this->buffers[side].ReadSamples(this->scratch[side].data(), count);
+    }
+
+    this->samples.resize(count);
+    for (size_t i = 0; i < count; i++)
+        this->samples[i] = { this->scratch[0][i], this->scratch[1][i] };
+
+    /* Backpressure: wait for the consumer instead of dropping samples, unless it is gone */
+    size_t written = 0;
+    while (true) {
+        written += this->output->Write(this->samples.data() + written, count - written);
+        if (written == count || this->output->IsClosed())
+            break;
+        std::this_thread::yield();
+    }
+}
+
+uint8_t APUCore::Read(uint16_t address)
+{
+    if (address >= WaveRAMAddress)
+        return this->GetRegister(address);
+
+    if (address == NR52Address) {
+        uint8_t status = this->powered ? 0xF0 : 0x70;
+        for (int n = 0; n < 4; n++) {
+            if (this->channels[n].enabled)
+                status |= 1 << n;
+        }
+        return status;
+    }
+
+    return this->GetRegister(address) | ReadMasks[address - NR10Address];
+}
+
+void APUCore::Write(uint64_t now, uint16_t address, uint8_t byte)
+{
+    this->Run(now);
+
+    if (address >= WaveRAMAddress) {
+        this->GetRegister(address) = byte;
+        this->UpdateAmplitudes(now);
+        return;
+    }
+
+    if (address == NR52Address) {
+        if (!(byte & 0x80) && this->powered) {
+            this->PowerOff();
+        } else if ((byte & 0x80) && !this->powered) {
+            this->powered = true;
+            this->sequencerStep = 0;
+        }
+        this->UpdateAmplitudes(now);
+        return;
+    }
+
+    if (!this->powered || address > NR52Address)
+        return;
+
+    this->GetRegister(address) = byte;
+
+    if (address < NR50Address) {
+        int n = (address - NR10Address) / 5;
+        int r = (address - NR10Address) % 5;
+        Channel& channel = this->channels[n];
+
+        switch (r) {
+            case 0:
+                if (n == 2) {
+                    channel.dacEnabled = byte & 0x80;
+                    channel.enabled &= channel.dacEnabled;
+                }
+                break;
+            case 1:
+                channel.length = (n == 2) ? 256 - byte : 64 - (byte & 0x3F);
+                break;
+            case 2:
+                if (n != 2) {
+                    channel.dacEnabled = byte & 0xF8;
+                    channel.enabled &= channel.dacEnabled;
+                }
+                break;
+            case 3:
+                this->UpdatePeriod(n);
+                break;
+            case 4:
+                channel.lengthEnabled = byte & 0x40;
+                this->UpdatePeriod(n);
+                if (byte & 0x80)
+                    this->Trigger(n, now);
+                break;
+        }
+    }
+
+    this->UpdateAmplitudes(now);
+}
+
+void APUCore::StepSequencer(void)
+{
+    if (!(this->sequencerStep & 1))
+        this->ClockLength();
+    if (this->sequencerStep == 2 || this->sequencerStep == 6)
+        this->ClockSweep();
+    if (this->sequencerStep == 7)
+        this->ClockEnvelope();
+
+    this->sequencerStep = (this->sequencerStep + 1) & 7;
+}
+
+void APUCore::Run(uint64_t now)
+{
+    while (this->nextStep <= now) {
+        uint64_t step = this->nextStep;
+        this->Sync(step);
+
+        if (this->powered) {
+            this->StepSequencer();
+            this->UpdateAmplitudes(step);
+        }
+
+        if (this->output) {
+            for (BlipBuffer& buffer : this->buffers)
+                buffer.EndFrame(step - this->frameStart);
+            this->frameStart = step;
+            this->Flush();
+        }
+
+        this->nextStep = step + SequencerCycles;
+    }
+
+    this->Sync(now);
+}
+
+APU::APU(MemoryMap& mmap, CPU& cpu, AudioRing *output, SynthesisMode mode, uint32_t sampleRate)
+: mmap(mmap), cpu(cpu), mode(mode),
+  core((mode == SynthesisInline) ? output : nullptr, sampleRate, cpu.GetCycles()),
+  queue(output && mode == SynthesisThreaded ? 1 << 14 : 1)
+{
+    this->segment = new IOSegment("APU", APUCore::NR10Address, APUCore::EndAddress, this);
+    this->mmap.AddSegment(this->segment);
+
+    this->eventId = this->cpu.GetScheduler().Register(this);
+    if (!output)
+        return;
+
+    uint64_t now = this->cpu.GetCycles();
+    if (this->mode == SynthesisThreaded) {
+        this->audioCore.reset(new APUCore(output, sampleRate, now));
+        this->worker = std::thread(&APU::Work, this);
+        this->cpu.GetScheduler().Schedule(this->eventId, now + FrameCycles);
+    } else {
+        this->cpu.GetScheduler().Schedule(this->eventId, now + APUCore::SequencerCycles);
+    }
+}
+
+APU::~APU()
+{
+    this->Finish();
+    this->cpu.GetScheduler().Cancel(this->eventId);
+    delete this->segment;
+}
+
+void APU::Push(const Entry& entry)
+{
+    /* Backpressure: the CPU may only get a queue ahead of the audio thread */
+    while (!this->queue.Write(&entry, 1))
+        std::this_thread::yield();
+}
+
+void APU::Work(void)
+{
+    Entry entries[256];
+
+    while (true) {
+        size_t count = this->queue.Read(entries, sizeof(entries) / sizeof(entries[0]));
+        if (!count) {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            continue;
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            const Entry& entry = entries[i];
+
+            switch (entry.type) {
+                case EntryWrite:
+                    this->audioCore->Write(entry.cycles, entry.address, entry.byte);
+                    break;
+                case EntrySync:
+                    this->audioCore->Run(entry.cycles);
+                    break;
+                case EntryStop:
+                    this->audioCore->Run(entry.cycles);
+                    return;
+            }
+        }
+    }
+}
+
+void APU::Finish(void)
+{
+    if (this->audioCore) {
+        this->Push({ this->cpu.GetCycles(), 0, 0, EntryStop });
+        this->worker.join();
+        this->audioCore.reset();
+    } else {
+        this->core.Run(this->cpu.GetCycles());
+    }
+
+    this->cpu.GetScheduler().Cancel(this->eventId);
+}
+
+uint8_t APU::ReadRegister(uint16_t address)
+{
+    this->core.Run(this->cpu.GetCycles());
+    return this->core.Read(address);
+}
+
+void APU::WriteRegister(uint16_t address, uint8_t byte)
+{
+    uint64_t now = this->cpu.GetCycles();
+    this->core.Write(now, address, byte);
+
+    if (this->audioCore)
+        this->Push({ now, address, byte, EntryWrite });
+}
+
+void APU::OnEvent(uint64_t deadline)
+{
+    if (this->audioCore) {
+        this->Push({ deadline, 0, 0, EntrySync });
+        this->cpu.GetScheduler().Schedule(this->eventId, deadline + FrameCycles);
+    } else {
+        this->core.Run(deadline);
+        this->cpu.GetScheduler().Schedule(this->eventId, deadline + APUCore::SequencerCycles);
+    }
+}
+
+};
@@ -0,0 +1,67 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "audio/BlipBuffer.hpp"
+
+namespace GameBoy
+{
+
+BlipBuffer::BlipBuffer(uint32_t clockRate, uint32_t sampleRate, size_t capacity)
+: offset(0), integrator(0)
+{
+    this->factor = (static_cast<uint64_t>(sampleRate) << TimeBits) / clockRate;
+    this->buffer.resize(capacity + KernelSize, 0);
+
+    /* Blackman windowed sinc, cut off a bit below Nyquist */
+    const double cutoff = 0.9;
+    const double pi = std::acos(-1.0);
+
+    for (int phase = 0; phase < Phases; phase++) {
+        double impulse[KernelSize];
+        double sum = 0;
+
+        for (int i = 0; i < KernelSize; i++) {
+            double x = i - (KernelSize / 2 - 1) - static_cast<double>(phase) / Phases;
+            double w = (i + 1 - static_cast<double>(phase) / Phases) / KernelSize;
+            double window = 0.42 - 0.5 * std::cos(2 * pi * w) + 0.08 * std::cos(4 * pi * w);
+            double sinc = (x == 0) ? 1.0 : std::sin(pi * cutoff * x) / (pi * cutoff * x);
+
+            impulse[i] = sinc * window;
+            sum += impulse[i];
+        }
+
+        /* Every phase must add exactly one unit, or steps would leave DC behind */
+        int error = 1 << DeltaBits;
+        for (int i = 0; i < KernelSize; i++) {
+            this->kernel[phase][i] = std::lround(impulse[i] / sum * (1 << DeltaBits));
+            error -= this->kernel[phase][i];
+        }
+        this->kernel[phase][KernelSize / 2 - 1] += error;
+    }
+}
+
+size_t BlipBuffer::ReadSamples(int16_t *samples, size_t count)
+{
+    count = std::min(count, this->GetSamplesAvailable());
+
+    int32_t sum = this->integrator;
+    for (size_t i = 0; i < count; i++) {
+        int32_t sample = sum >> DeltaBits;
+        sum += this->buffer[i];
+
+        samples[i] = std::max<int32_t>(INT16_MIN, std::min<int32_t>(INT16_MAX, sample));
+        sum -= sample << (DeltaBits - BassShift);
+    }
+    this->integrator = sum;
+
+    /* Keep the tail, it holds the impulses of the next frame */
+    std::memmove(this->buffer.data(), this->buffer.data() + count,
+                 (this->buffer.size() - count) * sizeof(int32_t));
+    std::fill(this->buffer.end() - count, this->buffer.end(), 0);
+
+    this->offset -= static_cast<uint64_t>(count) << TimeBits;
+    return count;
+}
+
+};
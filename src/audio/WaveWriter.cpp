@@ -0,0 +1,99 @@
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+#include "audio/WaveWriter.hpp"
+
+namespace GameBoy
+{
+
+struct WaveHeader {
+    char riff[4];           /* "RIFF" */
+    uint32_t riffSize;
+    char wave[4];           /* "WAVE" */
+    char fmt[4];            /* "fmt " */
+    uint32_t fmtSize;
+    uint16_t format;
+    uint16_t nChannels;
+    uint32_t sampleRate;
+    uint32_t byteRate;
+    uint16_t blockAlign;
+    uint16_t bitsPerSample;
+    char data[4];           /* "data" */
+    uint32_t dataSize;
+};
+
+WaveWriter::WaveWriter(const std::string& path, AudioRing& ring, uint32_t sampleRate)
+: ring(ring), sampleRate(sampleRate), nSamples(0), closing(false)
+{
+    this->file = std::fopen(path.c_str(), "wb");
+    if (!this->file)
+        throw std::runtime_error("Cannot open WAV file");
+
+    this->WriteHeader();
+    this->worker = std::thread(&WaveWriter::Work, this);
+}
+
+WaveWriter::~WaveWriter()
+{
+    this->Close();
+}
+
+void WaveWriter::WriteHeader(void)
+{
+    uint32_t dataSize = this->nSamples * sizeof(StereoSample);
+
+    WaveHeader header;
+    std::memcpy(header.riff, "RIFF", 4);
+    header.riffSize = sizeof(header) - 8 + dataSize;
+    std::memcpy(header.wave, "WAVE", 4);
+    std::memcpy(header.fmt, "fmt ", 4);
+    header.fmtSize = 16;
+    header.format = 1;
+    header.nChannels = 2;
+    header.sampleRate = this->sampleRate;
+    header.byteRate = this->sampleRate * sizeof(StereoSample);
+    header.blockAlign = sizeof(StereoSample);
+    header.bitsPerSample = 16;
+    std::memcpy(header.data, "data", 4);
+    header.dataSize = dataSize;
+
+    std::fseek(this->file, 0, SEEK_SET);
+    std::fwrite(&header, sizeof(header), 1, this->file);
+}
+
+void WaveWriter::Work(void)
+{
+    StereoSample samples[4096];
+
+    while (true) {
+        /* Read the flag first so that nothing pushed before Close() is missed */
+        bool closing = this->closing.load();
+        size_t count = this->ring.Read(samples, sizeof(samples) / sizeof(samples[0]));
+
+        if (count) {
+            std::fwrite(samples, sizeof(StereoSample), count, this->file);
+            this->nSamples += count;
+        } else if (closing) {
+            break;
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+}
+
+void WaveWriter::Close(void)
+{
+    if (!this->file)
+        return;
+
+    this->closing = true;
+    this->worker.join();
+    this->ring.Close();
+
+    this->WriteHeader();
+    std::fclose(this->file);
+    this->file = nullptr;
+}
+
+};
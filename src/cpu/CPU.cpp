@@ -1,10 +1,17 @@
 #include "cpu/CPU.hpp"
+#include "debug/Debugger.hpp"
+#include "SpeedSwitch.hpp"
 
 namespace GameBoy 
 {
 
-CPU::CPU(MemoryInterface &mmap) : mmap(mmap)
+CPU::CPU(MemoryInterface &mmap)
+: speedSwitch(nullptr), interruptController(nullptr), debugger(nullptr), mmap(mmap), bus(&mmap)
 {
+#ifdef GBEMU_PROFILE
+    this->profiler = nullptr;
+#endif
+
     this->Reset();
 }
 
@@ -15,13 +22,124 @@ void CPU::Reset()
     this->registers.f = 0;
 
     this->cycles = 0;
+    this->mcycle = 4;
+    this->busLockedUntil = 0;
 
     this->status = StatusRunning;
+    this->interrupts = false;
+    this->interruptShadow = false;
+    this->haltBug = false;
 }
 
 uint64_t CPU::Step()
 {
+    this->Execute();
+
+    if (this->cycles >= this->scheduler.GetNextDeadline())
+        this->scheduler.Dispatch(this->cycles);
+
+    return this->cycles;
+}
+
+uint64_t CPU::Run(uint64_t budget)
+{
+    /* Breakpoints and watchpoints are only looked at while some are set */
+    if (this->debugger && this->debugger->IsActive())
+        return this->RunDebug(budget);
+
+    uint64_t target = this->cycles + budget;
+
+    while (this->cycles < target && this->status != StatusStopped) {
+        if (this->status == StatusHalted && !this->HasPendingInterrupt())
+            this->Idle(target);
+        else
+            this->Execute();
+
+        if (this->cycles >= this->scheduler.GetNextDeadline())
+            this->scheduler.Dispatch(this->cycles);
+    }
+
+    return this->cycles;
+}
+
+/* Same as Run(), stopping on breakpoints and watchpoints */
+uint64_t CPU::RunDebug(uint64_t budget)
+{
+    uint64_t target = this->cycles + budget;
+
+    /* Resuming from a breakpoint executes the instruction it stopped on, unless PC was moved since */
+    bool resuming = this->debugger->GetStopReason() == Debugger::StopBreakpoint
+        && this->debugger->GetStopPC() == this->registers.pc;
+    this->debugger->ClearStop();
+
+    while (this->cycles < target && this->status != StatusStopped) {
+        if (this->status == StatusRunning && !resuming
+            && this->debugger->HasBreakpoint(this->registers.pc)) {
+            this->debugger->OnBreakpoint(this->registers.pc);
+            break;
+        }
+        resuming = false;
+
+        if (this->status == StatusHalted && !this->HasPendingInterrupt())
+            this->Idle(target);
+        else
+            this->Execute();
+
+        if (this->cycles >= this->scheduler.GetNextDeadline())
+            this->scheduler.Dispatch(this->cycles);
+
+        if (this->debugger->IsStopRequested())
+            break;
+    }
+
+    return this->cycles;
+}
+
+/* Halted with nothing pending: only a device event can change that */
+void CPU::Idle(uint64_t limit)
+{
+    uint64_t next = std::min(this->scheduler.GetNextDeadline(), limit);
+
+    if (next == Scheduler::Never || next < this->cycles + this->mcycle)
+        this->cycles += this->mcycle;
+    else
+        this->cycles = next;
+}
+
+void CPU::Execute()
+{
+    if (this->HasPendingInterrupt()) {
+        /* Any pending interrupt wakes the CPU up, even with IME=0 */
+        if (this->status == StatusHalted)
+            this->status = StatusRunning;
+
+        if (this->interrupts && !this->interruptShadow) {
+            this->ServiceInterrupt();
+            return;
+        }
+    }
+
+    this->interruptShadow = false;
+
+    if (this->status != StatusRunning) {
+        this->Idle(Scheduler::Never);
+        return;
+    }
+
+#ifdef GBEMU_PROFILE
+    uint16_t pc = this->registers.pc;
+    uint64_t start = this->cycles;
+#endif
+
     uint8_t opcode = this->FetchByte();
+    if (this->haltBug) {
+        this->registers.pc--;
+        this->haltBug = false;
+    }
+
+#ifdef GBEMU_PROFILE
+    uint8_t prefix = opcode;
+#endif
 
     /* 8 bits loads */
     if ((opcode & 0xc0) == 0x40 && opcode != 0x76) {
@@ -194,6 +312,7 @@ uint64_t CPU::Step()
         this->WriteHalfWordCycled(nn, this->registers.sp);
     } else if (opcode == 0xf9) {
         /* LD SP, HL */
+        this->InternalDelay();
         this->registers.sp = this->registers.GetHL();
     } else if (opcode == 0xf8) {
         /* LDHL SP, n */
@@ -204,11 +323,13 @@ uint64_t CPU::Step()
         this->registers.SetZero(0);
         this->registers.SetSubstract(0);
 
+        this->InternalDelay();
         this->registers.SetHL(this->registers.sp + n);
     } else if ((opcode & 0xcf) == 0xc5) {
         /* PUSH rr */
         uint8_t srcId = (opcode & 0x30) >> 4;
         uint16_t nn = this->GetHalfWordRegister(srcId, true);
+        this->InternalDelay();
         this->Push(nn);
     } else if ((opcode & 0xcf) == 0xc1) {
         /* POP rr */
@@ -230,6 +351,7 @@ uint64_t CPU::Step()
         this->registers.SetCarry((tmp & 0x10000) >> 16);
         this->registers.SetSubstract(0);
 
+        this->InternalDelay();
         this->registers.SetHL(tmp);
     } else if (opcode == 0xe8) {
         /* ADD SP, n */
@@ -240,14 +362,18 @@ uint64_t CPU::Step()
         this->registers.SetZero(0);
         this->registers.SetSubstract(0);
         
+        this->InternalDelay();
+        this->InternalDelay();
         this->registers.sp += n;
     } else if ((opcode & 0xcf) == 0x03) {
         /* INC rr */
         uint8_t dstId = (opcode & 0x30) >> 4;
+        this->InternalDelay();
         this->SetHalfWordRegister(dstId, this->GetHalfWordRegister(dstId, false) + 1, false);
     } else if ((opcode & 0xcf) == 0x0b) {
         /* DEC rr */
         uint8_t dstId = (opcode & 0x30) >> 4;
+        this->InternalDelay();
         this->SetHalfWordRegister(dstId, this->GetHalfWordRegister(dstId, false) - 1, false);
     }
 
@@ -300,6 +426,8 @@ uint64_t CPU::Step()
         /* RET cc */
         enum Condition cc = (enum Condition) ((opcode & 0x18) >> 3);
 
+        /* The condition is checked in an M-cycle of its own */
+        this->InternalDelay();
         if (this->IsConditionSatisfied(cc))
             this->SetPCCycled(this->Pop());
     } else if (opcode == 0xd9) {
@@ -450,27 +578,41 @@ uint64_t CPU::Step()
         /* NOP */
     } else if (opcode == 0x76) {
         /* HALT */
-        this->status = StatusHalted;
+        if (!this->interrupts && this->interruptController
+            && this->interruptController->GetPending())
+            this->haltBug = true;
+        else
+            this->status = StatusHalted;
     } else if (opcode == 0xF3) {
         /* DI */
         this->interrupts = false;
     } else if (opcode == 0xFB) {
         /* EI */
         this->interrupts = true;
+        this->interruptShadow = true;
     } else if (opcode == 0x10) {
-        opcode = this->FetchByte();
+        /* STOP is 2 bytes long but takes a single M-cycle */
+        opcode = this->bus->LoadByte(this->registers.pc++);
+        /* CGB speed switch, armed through KEY1 */
+        if (this->speedSwitch && this->speedSwitch->IsArmed()) {
+            this->speedSwitch->Switch();
+        } else {
         //if (opcode == 0) {
             this->status = StatusStopped;
         //} else {
         //    throw std::runtime_error("Illegal Instruction");
         //}
+        }
     }
 
     else {
         throw std::runtime_error("Illegal Instruction");
     }
 
-    return this->cycles;
+#ifdef GBEMU_PROFILE
+    if (this->profiler)
+        this->profiler->Record(pc, prefix, opcode, this->cycles - start);
+#endif
 }
 
 void CPU::AAdd(uint8_t value, bool carry)
@@ -667,9 +809,22 @@ void CPU::RotateRight(uint8_t id, bool through_carry)
     this->SetByteRegister(id, reg);
 }
 
+void CPU::ServiceInterrupt(void)
+{
+    enum InterruptController::Interrupt i = this->interruptController->GetHighestPriority();
+
+    this->interrupts = false;
+    this->interruptController->Acknowledge(i);
+
+    /* 2 wait states, push PC, jump to the vector: 5 M-cycles */
+    this->cycles += 2 * this->mcycle;
+    this->Push(this->registers.pc);
+    this->SetPCCycled(InterruptController::GetVector(i));
+}
+
 Instruction CPU::DecodeNextInstruction() const
 {
-    uint8_t fakePC = this->GetPC();
+    uint16_t fakePC = this->GetPC();
     uint8_t opcode = this->mmap.LoadByte(fakePC++);
 
     bool isCB = false;
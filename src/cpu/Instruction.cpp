@@ -1,66 +1,89 @@
+#include <algorithm>
+#include <cstdio>
+
 #include "cpu/Instruction.hpp"
 
 namespace GameBoy 
 {
 
-std::vector<uint8_t> Instruction::GetBytecode() const
+Instruction Instruction::Decode(const uint8_t *bytes)
 {
-    std::vector<uint8_t> bytecode;
-    if (this->isCB)
-        bytecode.push_back(0xCB);
-    bytecode.push_back(opcode);
+    bool isCB = (bytes[0] == 0xCB);
+    if (isCB)
+        bytes++;
 
-    switch (this->baseInstruction->GetArgumentType()) {
+    Instruction instr(bytes[0], isCB);
+    switch (instr.baseInstruction->GetArgumentType()) {
         case Immediate8:
-            bytecode.push_back(this->arg8);
+            instr.SetByteArgument(bytes[1]);
             break;
         case Immediate16:
-            bytecode.push_back(this->arg16 & 0xff);
-            bytecode.push_back((this->arg16 >> 8) & 0xff);
+            instr.SetHalfwordArgument(bytes[1] | (bytes[2] << 8));
             break;
         case NoImmediate:
         default:
             break;
     }
 
-    return bytecode;
+    return instr;
+}
+
+uint8_t Instruction::GetLength() const
+{
+    return this->baseInstruction->GetLength();
 }
 
-std::string Instruction::GetString() const
+uint8_t Instruction::GetBytecode(uint8_t *bytes) const
 {
-    uint8_t strArgSize = 0;
+    uint8_t length = 0;
+    if (this->isCB)
+        bytes[length++] = 0xCB;
+    bytes[length++] = opcode;
+
     switch (this->baseInstruction->GetArgumentType()) {
-        case NoImmediate:   strArgSize = 0; break;
-        case Immediate8:    strArgSize = 2; break;
-        case Immediate16:   strArgSize = 4; break;
+        case Immediate8:
+            bytes[length++] = this->arg8;
+            break;
+        case Immediate16:
+            bytes[length++] = this->arg16 & 0xff;
+            bytes[length++] = (this->arg16 >> 8) & 0xff;
+            break;
+        case NoImmediate:
         default:
             break;
     }
 
-    const std::string& format = this->baseInstruction->GetFormat();
+    return length;
+}
+
+size_t Instruction::Disassemble(char *buffer, size_t size) const
+{
+    if (size == 0)
+        return 0;
 
-    uint8_t strTotalSize = format.size() + strArgSize;
-    /* TODO: use unique_ptr */
-    uint8_t *tmp = new uint8_t [strTotalSize + 1];
-    tmp[strTotalSize] = 0;
+    const char *format = this->baseInstruction->GetFormat();
+    size_t length = 0;
 
     switch (this->baseInstruction->GetArgumentType()) {
-        case NoImmediate:
-            std::strncpy((char*) tmp, format.c_str(), strTotalSize);
-            break;
-        case Immediate8:    
-            std::snprintf((char*) tmp, strTotalSize, format.c_str(), this->arg8);
+        case Immediate8:
+            length = std::snprintf(buffer, size, format, this->arg8);
             break;
         case Immediate16:
-            std::snprintf((char*) tmp, strTotalSize, format.c_str(), this->arg16);
+            length = std::snprintf(buffer, size, format, this->arg16);
             break;
+        case NoImmediate:
         default:
+            length = std::strlen(format);
+            std::memcpy(buffer, format, std::min(length + 1, size));
+            buffer[size - 1] = 0;
             break;
     }
 
-    std::string s((char*) tmp);
+    /* Truncated output */
+    if (length >= size)
+        length = size - 1;
 
-    return s;
+    return length;
 }
 
 };
\ No newline at end of file
@@ -0,0 +1,85 @@
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+#include "cpu/Profiler.hpp"
+
+namespace GameBoy
+{
+
+static const char ProfileMagic[4] = { 'G', 'B', 'P', 'F' };
+static const uint32_t ProfileVersion = 1;
+
+void Profiler::Reset(void)
+{
+    std::memset(this->opcodes, 0, sizeof(this->opcodes));
+    std::memset(this->opcodesCB, 0, sizeof(this->opcodesCB));
+    std::memset(this->addresses, 0, sizeof(this->addresses));
+}
+
+void Profiler::Save(const std::string& path, const MemoryMap& mmap) const
+{
+    std::vector<AddressEntry> entries;
+
+    for (uint32_t pc = 0; pc < 0x10000; pc++) {
+        if (!this->addresses[pc].executions)
+            continue;
+
+        AddressEntry entry;
+        std::memset(&entry, 0, sizeof(entry));
+        entry.pc = pc;
+        mmap.Peek(pc, entry.bytecode, sizeof(entry.bytecode));
+        entry.counter = this->addresses[pc];
+        entries.push_back(entry);
+    }
+
+    FILE *file = std::fopen(path.c_str(), "wb");
+    if (!file)
+        throw std::runtime_error("Cannot open profile file");
+
+    uint32_t nEntries = entries.size();
+    std::fwrite(ProfileMagic, sizeof(ProfileMagic), 1, file);
+    std::fwrite(&ProfileVersion, sizeof(ProfileVersion), 1, file);
+    std::fwrite(this->opcodes, sizeof(this->opcodes), 1, file);
+    std::fwrite(this->opcodesCB, sizeof(this->opcodesCB), 1, file);
+    std::fwrite(&nEntries, sizeof(nEntries), 1, file);
+    std::fwrite(entries.data(), sizeof(AddressEntry), entries.size(), file);
+    std::fclose(file);
+}
+
+std::vector<Profiler::AddressEntry> Profiler::Load(const std::string& path)
+{
+    FILE *file = std::fopen(path.c_str(), "rb");
+    if (!file)
+        throw std::runtime_error("Cannot open profile file");
+
+    char magic[4];
+    uint32_t version, nEntries;
+    std::vector<AddressEntry> entries;
+
+    bool valid = std::fread(magic, sizeof(magic), 1, file) == 1
+              && std::memcmp(magic, ProfileMagic, sizeof(magic)) == 0
+              && std::fread(&version, sizeof(version), 1, file) == 1
+              && version == ProfileVersion
+              && std::fread(this->opcodes, sizeof(this->opcodes), 1, file) == 1
+              && std::fread(this->opcodesCB, sizeof(this->opcodesCB), 1, file) == 1
+              && std::fread(&nEntries, sizeof(nEntries), 1, file) == 1
+              && nEntries <= 0x10000;
+
+    if (valid) {
+        entries.resize(nEntries);
+        valid = std::fread(entries.data(), sizeof(AddressEntry), nEntries, file) == nEntries;
+    }
+
+    std::fclose(file);
+    if (!valid)
+        throw std::runtime_error("Not a profile file");
+
+    std::memset(this->addresses, 0, sizeof(this->addresses));
+    for (const AddressEntry& entry : entries)
+        this->addresses[entry.pc] = entry.counter;
+
+    return entries;
+}
+
+};
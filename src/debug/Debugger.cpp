@@ -0,0 +1,128 @@
+#include <cstring>
+
+#include "debug/Debugger.hpp"
+
+namespace GameBoy
+{
+
+uint8_t Watchpoint::LoadByte(uint16_t address) const
+{
+    MemorySegment *below = this->GetBelow(address);
+    uint8_t byte = below ? below->LoadByte(address) : 0xFF;
+
+    if ((this->type & WatchRead) && this->debugger.IsCPUAccess(address, false))
+        this->debugger.OnWatch(address, WatchRead, byte, this->type);
+    return byte;
+}
+
+void Watchpoint::WriteByte(uint16_t address, const uint8_t byte)
+{
+    if ((this->type & WatchWrite) && this->debugger.IsCPUAccess(address, true))
+        this->debugger.OnWatch(address, WatchWrite, byte, this->type);
+
+    MemorySegment *below = this->GetBelow(address);
+    if (below)
+        below->WriteByte(address, byte);
+}
+
+Debugger::Debugger(MemoryMap& mmap, CPU& cpu)
+: mmap(mmap), cpu(cpu), nBreakpoints(0), bus(mmap), stopReason(StopNone), stopPC(0)
+{
+    std::memset(this->breakpoints, 0, sizeof(this->breakpoints));
+    std::memset(&this->watchHit, 0, sizeof(this->watchHit));
+    this->cpu.SetDebugger(this);
+}
+
+Debugger::~Debugger()
+{
+    this->cpu.SetDebugger(nullptr);
+    this->cpu.SetBus(nullptr);
+
+    for (Watchpoint *watchpoint : this->watchpoints) {
+        this->mmap.RemoveSegment(watchpoint);
+        delete watchpoint;
+    }
+}
+
+void Debugger::AddBreakpoint(uint16_t pc)
+{
+    if (this->HasBreakpoint(pc))
+        return;
+
+    this->breakpoints[pc >> 6] |= (1ULL << (pc & 63));
+    this->nBreakpoints++;
+}
+
+void Debugger::RemoveBreakpoint(uint16_t pc)
+{
+    if (!this->HasBreakpoint(pc))
+        return;
+
+    this->breakpoints[pc >> 6] &= ~(1ULL << (pc & 63));
+    this->nBreakpoints--;
+}
+
+void Debugger::AddWatchpoint(uint16_t begin, uint32_t end, Watchpoint::Type type)
+{
+    Watchpoint *watchpoint = new Watchpoint(this->mmap, *this, begin, end, type);
+    this->watchpoints.push_back(watchpoint);
+    this->mmap.InsertSegment(watchpoint);
+    this->cpu.SetBus(&this->bus);
+}
+
+bool Debugger::RemoveWatchpoint(uint16_t begin, uint32_t end, Watchpoint::Type type)
+{
+    for (auto it = this->watchpoints.begin(); it != this->watchpoints.end(); ++it) {
+        Watchpoint *watchpoint = *it;
+        if (watchpoint->GetBegin() != begin || watchpoint->GetEnd() != end
+            || watchpoint->GetType() != type)
+            continue;
+
+        this->mmap.RemoveSegment(watchpoint);
+        this->watchpoints.erase(it);
+        delete watchpoint;
+        if (this->watchpoints.empty())
+            this->cpu.SetBus(nullptr);
+        return true;
+    }
+
+    return false;
+}
+
+/* Segment serving address once watchpoints are looked through */
+static MemorySegment *GetUnwatchedSegment(const MemoryMap& mmap, uint16_t address)
+{
+    MemorySegment *segment = mmap.GetSegment(address);
+    while (segment && dynamic_cast<Watchpoint*>(segment))
+        segment = mmap.GetSegmentBelow(segment, address);
+    return segment;
+}
+
+uint8_t Debugger::PeekByte(uint16_t address) const
+{
+    MemorySegment *segment = GetUnwatchedSegment(this->mmap, address);
+    return segment ? segment->LoadByte(address) : 0xFF;
+}
+
+void Debugger::PokeByte(uint16_t address, uint8_t byte)
+{
+    MemorySegment *segment = GetUnwatchedSegment(this->mmap, address);
+    if (segment)
+        segment->WriteByte(address, byte);
+    this->mmap.MarkDirty(address);
+}
+
+void Debugger::OnWatch(uint16_t address, Watchpoint::Type type, uint8_t value, Watchpoint::Type watched)
+{
+    /* Keep the first hit of the instruction */
+    if (this->stopReason != StopNone)
+        return;
+
+    this->stopReason = StopWatchpoint;
+    this->watchHit.address = address;
+    this->watchHit.type = type;
+    this->watchHit.watched = watched;
+    this->watchHit.value = value;
+}
+
+};
@@ -0,0 +1,527 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "debug/GDBServer.hpp"
+
+namespace GameBoy
+{
+
+static const char TargetDescription[] =
+    "<?xml version=\"1.0\"?>"
+    "<!DOCTYPE target SYSTEM \"gdb-target.dtd\">"
+    "<target version=\"1.0\">"
+    "<feature name=\"org.gbemu.sm83.core\">"
+    "<reg name=\"a\" bitsize=\"8\" regnum=\"0\" type=\"uint8\"/>"
+    "<reg name=\"f\" bitsize=\"8\" type=\"uint8\"/>"
+    "<reg name=\"b\" bitsize=\"8\" type=\"uint8\"/>"
+    "<reg name=\"c\" bitsize=\"8\" type=\"uint8\"/>"
+    "<reg name=\"d\" bitsize=\"8\" type=\"uint8\"/>"
+    "<reg name=\"e\" bitsize=\"8\" type=\"uint8\"/>"
+    "<reg name=\"h\" bitsize=\"8\" type=\"uint8\"/>"
+    "<reg name=\"l\" bitsize=\"8\" type=\"uint8\"/>"
+    "<reg name=\"sp\" bitsize=\"16\" type=\"data_ptr\"/>"
+    "<reg name=\"pc\" bitsize=\"16\" type=\"code_ptr\"/>"
+    "</feature>"
+    "</target>";
+
+static const int NumberOfRegisters = 10;
+
+static std::string ToHex(const uint8_t *bytes, size_t size)
+{
+    static const char hex[] = "0123456789abcdef";
+    std::string s;
+
+    for (size_t i = 0; i < size; i++) {
+        s += hex[bytes[i] >> 4];
+        s += hex[bytes[i] & 0xf];
+    }
+    return s;
+}
+
+static bool FromHex(const std::string& hex, uint8_t *bytes, size_t size)
+{
+    if (hex.size() < size * 2)
+        return false;
+
+    for (size_t i = 0; i < size; i++) {
+        char digits[3] = { hex[i * 2], hex[i * 2 + 1], '\0' };
+        char *end;
+        bytes[i] = std::strtoul(digits, &end, 16);
+        if (*end != '\0')
+            return false;
+    }
+    return true;
+}
+
+/* Register n as little endian bytes, returns its size */
+static size_t GetRegister(const Registers& registers, int n, uint8_t *bytes)
+{
+    const uint8_t byteRegisters[] = {
+        registers.a, registers.f, registers.b, registers.c,
+        registers.d, registers.e, registers.h, registers.l,
+    };
+
+    if (n < 8) {
+        bytes[0] = byteRegisters[n];
+        return 1;
+    }
+
+    uint16_t value = (n == 8) ? registers.sp : registers.pc;
+    bytes[0] = value & 0xff;
+    bytes[1] = value >> 8;
+    return 2;
+}
+
+static void SetRegister(Registers& registers, int n, const uint8_t *bytes)
+{
+    uint8_t *byteRegisters[] = {
+        &registers.a, &registers.f, &registers.b, &registers.c,
+        &registers.d, &registers.e, &registers.h, &registers.l,
+    };
+
+    if (n < 8)
+        *byteRegisters[n] = bytes[0];
+    else if (n == 8)
+        registers.sp = bytes[0] | (bytes[1] << 8);
+    else
+        registers.pc = bytes[0] | (bytes[1] << 8);
+}
+
+GDBServer::GDBServer(MemoryMap& mmap, CPU& cpu, Debugger& debugger)
+: mmap(mmap), cpu(cpu), debugger(debugger), listenFd(-1), fd(-1), noAck(false), inputOffset(0)
+{
+}
+
+GDBServer::~GDBServer()
+{
+    if (this->fd >= 0)
+        close(this->fd);
+    if (this->listenFd >= 0)
+        close(this->listenFd);
+}
+
+void GDBServer::ListenTCP(uint16_t port)
+{
+    this->listenFd = socket(AF_INET, SOCK_STREAM, 0);
+    if (this->listenFd < 0)
+        throw std::runtime_error("Cannot create socket");
+
+    int yes = 1;
+    setsockopt(this->listenFd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+
+    /* Never reachable from other machines */
+    struct sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    if (bind(this->listenFd, (struct sockaddr*) &address, sizeof(address)) < 0
+        || listen(this->listenFd, 1) < 0)
+        throw std::runtime_error("Cannot listen on TCP port");
+}
+
+void GDBServer::ListenUnix(const std::string& path)
+{
+    this->listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (this->listenFd < 0)
+        throw std::runtime_error("Cannot create socket");
+
+    struct sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path))
+        throw std::runtime_error("Socket path too long");
+    std::strcpy(address.sun_path, path.c_str());
+
+    unlink(path.c_str());
+    if (bind(this->listenFd, (struct sockaddr*) &address, sizeof(address)) < 0
+        || listen(this->listenFd, 1) < 0)
+        throw std::runtime_error("Cannot listen on Unix socket");
+}
+
+bool GDBServer::ReadByte(char& c)
+{
+    if (this->inputOffset >= this->input.size()) {
+        char buffer[4096];
+        ssize_t n = recv(this->fd, buffer, sizeof(buffer), 0);
+        if (n <= 0)
+            return false;
+        this->input.assign(buffer, n);
+        this->inputOffset = 0;
+    }
+
+    c = this->input[this->inputOffset++];
+    return true;
+}
+
+bool GDBServer::ReceivePacket(std::string& packet)
+{
+    char c;
+
+    while (true) {
+        /* Skip acks and anything else up to the start of a packet */
+        do {
+            if (!this->ReadByte(c))
+                return false;
+        } while (c != '$');
+
+        packet.clear();
+        uint8_t sum = 0;
+        while (true) {
+            if (!this->ReadByte(c))
+                return false;
+            if (c == '#')
+                break;
+            packet += c;
+            sum += c;
+        }
+
+        char checksum[3] = { 0, 0, 0 };
+        if (!this->ReadByte(checksum[0]) || !this->ReadByte(checksum[1]))
+            return false;
+
+        bool valid = std::strtoul(checksum, nullptr, 16) == sum;
+        if (!this->noAck)
+            send(this->fd, valid ? "+" : "-", 1, 0);
+        if (valid)
+            return true;
+    }
+}
+
+void GDBServer::SendPacket(const std::string& payload)
+{
+    uint8_t sum = 0;
+    for (char c : payload)
+        sum += c;
+
+    char checksum[4];
+    std::snprintf(checksum, sizeof(checksum), "#%02x", sum);
+    std::string packet = "$" + payload + checksum;
+
+    while (true) {
+        send(this->fd, packet.data(), packet.size(), 0);
+        if (this->noAck)
+            return;
+
+        /* Resend until acknowledged */
+        char c;
+        do {
+            if (!this->ReadByte(c))
+                return;
+        } while (c != '+' && c != '-');
+
+        if (c == '+')
+            return;
+    }
+}
+
+bool GDBServer::IsInterruptPending(void)
+{
+    struct pollfd pfd = { this->fd, POLLIN, 0 };
+    if (poll(&pfd, 1, 0) <= 0)
+        return false;
+
+    char buffer[4096];
+    ssize_t n = recv(this->fd, buffer, sizeof(buffer), MSG_DONTWAIT);
+
+    /* A closed connection stops the target too, ReadByte() notices it next */
+    if (n <= 0)
+        return true;
+
+    this->input.append(buffer, n);
+
+    size_t position = this->input.find('\x03', this->inputOffset);
+    if (position == std::string::npos)
+        return false;
+
+    this->input.erase(position, 1);
+    return true;
+}
+
+std::string GDBServer::GetStopReply(void) const
+{
+    if (this->cpu.GetStatus() == CPU::StatusStopped)
+        return "W00";
+
+    if (this->debugger.GetStopReason() != Debugger::StopWatchpoint)
+        return "S05";
+
+    const Debugger::WatchHit& hit = this->debugger.GetWatchHit();
+    const char *kind = "awatch";
+    if (hit.watched == Watchpoint::WatchRead)
+        kind = "rwatch";
+    else if (hit.watched == Watchpoint::WatchWrite)
+        kind = "watch";
+
+    char reply[32];
+    std::snprintf(reply, sizeof(reply), "T05%s:%04x;", kind, hit.address);
+    return reply;
+}
+
+std::string GDBServer::ReadRegisters(void) const
+{
+    const Registers& registers = const_cast<CPU&>(this->cpu).GetRegisters();
+    std::string hex;
+
+    for (int n = 0; n < NumberOfRegisters; n++) {
+        uint8_t bytes[2];
+        size_t size = GetRegister(registers, n, bytes);
+        hex += ToHex(bytes, size);
+    }
+    return hex;
+}
+
+void GDBServer::WriteRegisters(const std::string& hex)
+{
+    Registers& registers = this->cpu.GetRegisters();
+    size_t offset = 0;
+
+    for (int n = 0; n < NumberOfRegisters; n++) {
+        uint8_t bytes[2];
+        size_t size = (n < 8) ? 1 : 2;
+        if (!FromHex(hex.substr(offset), bytes, size))
+            return;
+        SetRegister(registers, n, bytes);
+        offset += size * 2;
+    }
+}
+
+std::string GDBServer::ReadMemory(const std::string& arguments) const
+{
+    char *end;
+    uint32_t address = std::strtoul(arguments.c_str(), &end, 16);
+    if (*end != ',')
+        return "E01";
+    uint32_t size = std::strtoul(end + 1, nullptr, 16);
+
+    std::string hex;
+    for (uint32_t i = 0; i < size && address + i < 0x10000; i++) {
+        uint8_t byte = this->debugger.PeekByte(address + i);
+        hex += ToHex(&byte, 1);
+    }
+    return hex;
+}
+
+bool GDBServer::WriteMemory(const std::string& arguments)
+{
+    char *end;
+    uint32_t address = std::strtoul(arguments.c_str(), &end, 16);
+    if (*end != ',')
+        return false;
+    uint32_t size = std::strtoul(end + 1, &end, 16);
+    if (*end != ':' || address + size > 0x10000)
+        return false;
+
+    std::string hex(end + 1);
+    for (uint32_t i = 0; i < size; i++) {
+        uint8_t byte;
+        if (!FromHex(hex.substr(i * 2), &byte, 1))
+            return false;
+        this->debugger.PokeByte(address + i, byte);
+    }
+    return true;
+}
+
+bool GDBServer::SetBreakpoint(const std::string& arguments, bool insert)
+{
+    /* type,address,kind */
+    char *end;
+    int type = std::strtol(arguments.c_str(), &end, 16);
+    if (*end != ',')
+        return false;
+    uint32_t address = std::strtoul(end + 1, &end, 16);
+    if (*end != ',' || address > 0xffff)
+        return false;
+    uint32_t kind = std::strtoul(end + 1, nullptr, 16);
+
+    if (type == 0 || type == 1) {
+        if (insert)
+            this->debugger.AddBreakpoint(address);
+        else
+            this->debugger.RemoveBreakpoint(address);
+        return true;
+    }
+
+    static const Watchpoint::Type watchTypes[] = {
+        Watchpoint::WatchWrite, Watchpoint::WatchRead, Watchpoint::WatchAccess,
+    };
+    if (type < 2 || type > 4)
+        return false;
+
+    uint32_t watchEnd = std::min<uint32_t>(address + std::max<uint32_t>(kind, 1), 0x10000);
+    if (insert)
+        this->debugger.AddWatchpoint(address, watchEnd, watchTypes[type - 2]);
+    else
+        this->debugger.RemoveWatchpoint(address, watchEnd, watchTypes[type - 2]);
+    return true;
+}
+
+std::string GDBServer::ReadFeatures(const std::string& arguments) const
+{
+    /* target.xml:offset,length */
+    size_t colon = arguments.find(':');
+    if (arguments.compare(0, colon, "target.xml") != 0 || colon == std::string::npos)
+        return "E00";
+
+    char *end;
+    size_t offset = std::strtoul(arguments.c_str() + colon + 1, &end, 16);
+    size_t length = std::strtoul(end + 1, nullptr, 16);
+
+    std::string description(TargetDescription);
+    if (offset >= description.size())
+        return "l";
+
+    std::string chunk = description.substr(offset, length);
+    bool last = offset + chunk.size() >= description.size();
+    return (last ? "l" : "m") + chunk;
+}
+
+std::string GDBServer::Continue(void)
+{
+    /* Without breakpoints or watchpoints, Run() never clears a previous stop */
+    if (!this->debugger.IsActive())
+        this->debugger.ClearStop();
+
+    while (true) {
+        this->cpu.Run(RunCycles);
+
+        if (this->debugger.IsStopRequested() || this->cpu.GetStatus() == CPU::StatusStopped)
+            return this->GetStopReply();
+        if (this->IsInterruptPending())
+            return "S02";
+    }
+}
+
+std::string GDBServer::Step(void)
+{
+    this->debugger.ClearStop();
+    this->cpu.Step();
+    return this->GetStopReply();
+}
+
+void GDBServer::Serve(void)
+{
+    this->fd = accept(this->listenFd, nullptr, nullptr);
+    if (this->fd < 0)
+        throw std::runtime_error("Cannot accept GDB client");
+
+    int yes = 1;
+    setsockopt(this->fd, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes));
+
+    this->noAck = false;
+    this->input.clear();
+    this->inputOffset = 0;
+
+    std::string packet;
+    while (this->ReceivePacket(packet)) {
+        char command = packet.empty() ? '\0' : packet[0];
+        std::string arguments = packet.empty() ? "" : packet.substr(1);
+        std::string reply;
+
+        switch (command) {
+            case '?':
+                reply = this->GetStopReply();
+                break;
+            case 'g':
+                reply = this->ReadRegisters();
+                break;
+            case 'G':
+                this->WriteRegisters(arguments);
+                reply = "OK";
+                break;
+            case 'p': {
+                int n = std::strtol(arguments.c_str(), nullptr, 16);
+                if (n < 0 || n >= NumberOfRegisters) {
+                    reply = "E01";
+                    break;
+                }
+                uint8_t bytes[2];
+                size_t size = GetRegister(this->cpu.GetRegisters(), n, bytes);
+                reply = ToHex(bytes, size);
+                break;
+            }
+            case 'P': {
+                char *end;
+                int n = std::strtol(arguments.c_str(), &end, 16);
+                uint8_t bytes[2];
+                if (*end != '=' || n < 0 || n >= NumberOfRegisters
+                    || !FromHex(end + 1, bytes, (n < 8) ? 1 : 2)) {
+                    reply = "E01";
+                    break;
+                }
+                SetRegister(this->cpu.GetRegisters(), n, bytes);
+                reply = "OK";
+                break;
+            }
+            case 'm':
+                reply = this->ReadMemory(arguments);
+                break;
+            case 'M':
+                reply = this->WriteMemory(arguments) ? "OK" : "E01";
+                break;
+            case 'Z':
+            case 'z':
+                reply = this->SetBreakpoint(arguments, command == 'Z') ? "OK" : "";
+                break;
+            case 'c':
+                reply = this->Continue();
+                break;
+            case 's':
+                reply = this->Step();
+                break;
+            case 'H':
+                reply = "OK";
+                break;
+            case 'D':
+                this->SendPacket("OK");
+                close(this->fd);
+                this->fd = -1;
+                return;
+            case 'k':
+                close(this->fd);
+                this->fd = -1;
+                return;
+            case 'q':
+            case 'Q':
+                if (packet.compare(0, 10, "qSupported") == 0)
+                    reply = "PacketSize=1000;qXfer:features:read+;QStartNoAckMode+";
+                else if (packet.compare(0, 20, "qXfer:features:read:") == 0)
+                    reply = this->ReadFeatures(packet.substr(20));
+                else if (packet == "QStartNoAckMode") {
+                    this->SendPacket("OK");
+                    this->noAck = true;
+                    continue;
+                } else if (packet == "qAttached")
+                    reply = "1";
+                else if (packet == "qC")
+                    reply = "QC1";
+                else if (packet == "qfThreadInfo")
+                    reply = "m1";
+                else if (packet == "qsThreadInfo")
+                    reply = "l";
+                break;
+            default:
+                /* Unsupported packets get an empty reply */
+                break;
+        }
+
+        this->SendPacket(reply);
+    }
+
+    close(this->fd);
+    this->fd = -1;
+}
+
+};
@@ -0,0 +1,119 @@
+#include <cstring>
+#include <map>
+#include <string>
+
+#include "memory/AccessCounters.hpp"
+#include "memory/MemoryMap.hpp"
+
+namespace GameBoy
+{
+
+void AccessCounters::Reset(void)
+{
+    std::memset(this->reads, 0, sizeof(this->reads));
+    std::memset(this->writes, 0, sizeof(this->writes));
+    std::memset(&this->frameStart, 0, sizeof(this->frameStart));
+    this->frames.clear();
+}
+
+void AccessCounters::GetPageTotals(Frame& totals) const
+{
+    for (uint32_t page = 0; page < NumberOfPages; page++) {
+        uint64_t reads = 0, writes = 0;
+
+        for (uint32_t address = page * PageSize; address < (page + 1) * PageSize; address++) {
+            reads += this->reads[address];
+            writes += this->writes[address];
+        }
+
+        /* Truncated to 32 bits, per-frame deltas stay correct across wraps */
+        totals.reads[page] = reads;
+        totals.writes[page] = writes;
+    }
+}
+
+void AccessCounters::EndFrame(void)
+{
+    Frame totals, frame;
+    this->GetPageTotals(totals);
+
+    for (uint32_t page = 0; page < NumberOfPages; page++) {
+        frame.reads[page] = totals.reads[page] - this->frameStart.reads[page];
+        frame.writes[page] = totals.writes[page] - this->frameStart.writes[page];
+    }
+
+    this->frames.push_back(frame);
+    this->frameStart = totals;
+}
+
+void AccessCounters::Report(FILE *out, const MemoryMap& mmap) const
+{
+    struct Totals {
+        uint64_t reads;
+        uint64_t writes;
+    };
+
+    std::map<std::string, Totals> segments;
+    std::vector<uint16_t> unmapped;
+
+    for (uint32_t address = 0; address < 0x10000; address++) {
+        if (!this->reads[address] && !this->writes[address])
+            continue;
+
+        MemorySegment *segment = mmap.GetSegment(address);
+        if (!segment) {
+            unmapped.push_back(address);
+            continue;
+        }
+
+        Totals& totals = segments[segment->GetName()];
+        totals.reads += this->reads[address];
+        totals.writes += this->writes[address];
+    }
+
+    std::fprintf(out, "Segments:\n");
+    std::fprintf(out, "%-12s %14s %14s\n", "name", "reads", "writes");
+    for (const auto& segment : segments) {
+        std::fprintf(out, "%-12s %14llu %14llu\n", segment.first.c_str(),
+                     static_cast<unsigned long long>(segment.second.reads),
+                     static_cast<unsigned long long>(segment.second.writes));
+    }
+
+    std::fprintf(out, "\nUnmapped addresses:\n");
+    std::fprintf(out, "%-12s %14s %14s\n", "address", "reads", "writes");
+    for (uint16_t address : unmapped) {
+        std::fprintf(out, "%04X         %14llu %14llu\n", address,
+                     static_cast<unsigned long long>(this->reads[address]),
+                     static_cast<unsigned long long>(this->writes[address]));
+    }
+
+    std::fprintf(out, "\nPages:\n");
+    std::fprintf(out, "%-12s %14s %14s\n", "page", "reads", "writes");
+    for (uint32_t page = 0; page < NumberOfPages; page++) {
+        uint64_t reads = 0, writes = 0;
+        for (uint32_t address = page * PageSize; address < (page + 1) * PageSize; address++) {
+            reads += this->reads[address];
+            writes += this->writes[address];
+        }
+
+        if (reads || writes)
+            std::fprintf(out, "%02Xxx         %14llu %14llu\n", page,
+                         static_cast<unsigned long long>(reads),
+                         static_cast<unsigned long long>(writes));
+    }
+
+    /* One line per frame: page:reads/writes for every page touched */
+    std::fprintf(out, "\nFrames:\n");
+    for (size_t i = 0; i < this->frames.size(); i++) {
+        const Frame& frame = this->frames[i];
+
+        std::fprintf(out, "%zu", i);
+        for (uint32_t page = 0; page < NumberOfPages; page++) {
+            if (frame.reads[page] || frame.writes[page])
+                std::fprintf(out, " %02X:%u/%u", page, frame.reads[page], frame.writes[page]);
+        }
+        std::fprintf(out, "\n");
+    }
+}
+
+};
@@ -0,0 +1,272 @@
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "cpu/CPU.hpp"
+#include "cpu/Instruction.hpp"
+#include "memory/MemoryMap.hpp"
+#include "Cartridge.hpp"
+#include "Video.hpp"
+#include "Timer.hpp"
+
+/**
+ * Microbenchmarks of the hot paths
+ *
+ * Every input is generated from a fixed seed so that runs are comparable
+ * across revisions. Results are printed as one JSON object per line:
+ * {"benchmark": name, "iterations": n, "ns": total, "ns_per_op": ns / n}
+ */
+
+static const uint32_t Seed = 0x5eed1989;
+
+/* Keeps results alive so the measured work can't be optimized out */
+static volatile uint64_t sink;
+
+template <typename Function>
+static void Measure(const std::string& name, uint64_t iterations, Function function)
+{
+    auto start = std::chrono::steady_clock::now();
+    function(iterations);
+    auto end = std::chrono::steady_clock::now();
+
+    double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    std::printf("{\"benchmark\": \"%s\", \"iterations\": %llu, \"ns\": %.0f, \"ns_per_op\": %.3f}\n",
+                name.c_str(), static_cast<unsigned long long>(iterations), ns, ns / iterations);
+    std::fflush(stdout);
+}
+
+/* Register operands which never touch H or L, so (HL) keeps pointing to WRAM */
+static const uint8_t SafeRegisters[] = { 0, 1, 2, 3, 7 };
+
+static uint8_t RandomRegister(std::mt19937& rng)
+{
+    return SafeRegisters[rng() % sizeof(SafeRegisters)];
+}
+
+/**
+ * Fills program with random instructions of one kind, ending with a jump
+ * back to 0x0000 so the mix can be stepped through forever.
+ */
+static std::vector<uint8_t> GenerateMix(const std::string& kind, size_t size, std::mt19937& rng)
+{
+    std::vector<uint8_t> program;
+
+    while (program.size() < size - 3) {
+        uint16_t next;
+
+        if (kind == "alu") {
+            /* ADD/ADC/SUB/SBC/AND/XOR/OR/CP with a register or (HL), INC/DEC */
+            switch (rng() % 3) {
+                case 0: program.push_back(0x80 | (rng() % 8) << 3 | RandomRegister(rng)); break;
+                case 1: program.push_back(0x80 | (rng() % 8) << 3 | 6); break;
+                case 2: program.push_back(0x04 | RandomRegister(rng) << 3 | (rng() % 2)); break;
+            }
+        } else if (kind == "load") {
+            /* LD r,r', LD r,n, LD r,(HL), LD (HL),r */
+            switch (rng() % 4) {
+                case 0: program.push_back(0x40 | RandomRegister(rng) << 3 | RandomRegister(rng)); break;
+                case 1:
+                    program.push_back(0x06 | RandomRegister(rng) << 3);
+                    program.push_back(rng());
+                    break;
+                case 2: program.push_back(0x46 | RandomRegister(rng) << 3); break;
+                case 3: program.push_back(0x70 | RandomRegister(rng)); break;
+            }
+        } else if (kind == "branch") {
+            /* JR, JR cc, JP, JP cc all landing on the next instruction */
+            switch (rng() % 4) {
+                case 0:
+                    program.push_back(0x18);
+                    program.push_back(0x00);
+                    break;
+                case 1:
+                    program.push_back(0x20 | (rng() % 4) << 3);
+                    program.push_back(0x00);
+                    break;
+                case 2:
+                case 3:
+                    program.push_back((rng() % 2) ? 0xC3 : (0xC2 | (rng() % 4) << 3));
+                    next = program.size() + 2;
+                    program.push_back(next & 0xff);
+                    program.push_back(next >> 8);
+                    break;
+            }
+        } else if (kind == "cb") {
+            /* Rotates, shifts, BIT, RES, SET on registers and (HL) */
+            uint8_t operand = (rng() % 6) ? RandomRegister(rng) : 6;
+            program.push_back(0xCB);
+            program.push_back((rng() % 32) << 3 | operand);
+        }
+    }
+
+    /* JP 0x0000 */
+    program.resize(size - 3, 0x00);
+    program.push_back(0xC3);
+    program.push_back(0x00);
+    program.push_back(0x00);
+    return program;
+}
+
+static void BenchStep(const std::string& kind, uint64_t iterations)
+{
+    std::mt19937 rng(Seed);
+    std::vector<uint8_t> program = GenerateMix(kind, 0x4000, rng);
+
+    GameBoy::MemoryMap mmap;
+    GameBoy::CPU cpu(mmap);
+    GameBoy::MemorySegment rom(
+        "ROM", 0x0000, program.size(),
+        GameBoy::MemorySegment::Permissions::Read,
+        program.data());
+    mmap.AddSegment(&rom);
+
+    cpu.SetPC(0x0000);
+    cpu.GetRegisters().SetHL(0xC000);
+    cpu.GetRegisters().sp = 0xFFFE;
+
+    Measure("cpu.step." + kind, iterations, [&](uint64_t n) {
+        for (uint64_t i = 0; i < n; i++)
+            cpu.Step();
+    });
+
+    sink = cpu.GetCycles();
+}
+
+static void BenchMemory(uint64_t iterations)
+{
+    struct Region {
+        const char *name;
+        uint16_t begin;
+        uint32_t end;
+    };
+
+    /* ROM is mapped after the devices, as the tools do */
+    static const Region regions[] = {
+        { "rom",      0x0000, 0x8000 },
+        { "vram",     0x8000, 0xA000 },
+        { "unmapped", 0xA000, 0xC000 },
+        { "wram0",    0xC000, 0xD000 },
+        { "wram1",    0xD000, 0xE000 },
+        { "oam",      0xFE00, 0xFEA0 },
+        { "io",       0xFF04, 0xFF08 },
+        { "hram",     0xFF80, 0xFFFF },
+    };
+
+    GameBoy::MemoryMap mmap;
+    GameBoy::CPU cpu(mmap);
+    GameBoy::InterruptController interruptController(mmap);
+    GameBoy::Video video(mmap, cpu, interruptController);
+    GameBoy::Timer timer(mmap, cpu, interruptController);
+
+    std::vector<uint8_t> contents(0x8000);
+    GameBoy::MemorySegment rom(
+        "ROM", 0x0000, 0x8000,
+        GameBoy::MemorySegment::Permissions::ReadWrite,
+        contents.data());
+    mmap.AddSegment(&rom);
+
+    std::mt19937 rng(Seed);
+    std::vector<uint16_t> addresses(4096);
+
+    for (const Region& region : regions) {
+        for (uint16_t& address : addresses)
+            address = region.begin + rng() % (region.end - region.begin);
+
+        Measure(std::string("mmap.read.") + region.name, iterations, [&](uint64_t n) {
+            uint64_t sum = 0;
+            for (uint64_t i = 0; i < n; i++)
+                sum += mmap.LoadByte(addresses[i % addresses.size()]);
+            sink = sum;
+        });
+
+        /* Writing the timer registers would reschedule, keep to DIV reads */
+        if (std::string(region.name) == "io")
+            continue;
+
+        Measure(std::string("mmap.write.") + region.name, iterations, [&](uint64_t n) {
+            for (uint64_t i = 0; i < n; i++)
+                mmap.WriteByte(addresses[i % addresses.size()], i);
+        });
+    }
+}
+
+static void BenchDisassemble(uint64_t iterations)
+{
+    std::mt19937 rng(Seed);
+    std::vector<uint8_t> bytes(4096 + GameBoy::Instruction::MaxLength);
+    for (uint8_t& byte : bytes)
+        byte = rng();
+
+    Measure("instruction.disassemble", iterations, [&](uint64_t n) {
+        char buffer[GameBoy::Instruction::MaxStringLength];
+        uint64_t sum = 0;
+
+        for (uint64_t i = 0; i < n; i++) {
+            GameBoy::Instruction instr = GameBoy::Instruction::Decode(&bytes[i % 4096]);
+            sum += instr.Disassemble(buffer, sizeof(buffer));
+        }
+        sink = sum;
+    });
+}
+
+static void BenchCartridgeOpen(uint64_t iterations)
+{
+    /* 1 MiB MBC1 image with a valid header and random contents */
+    std::mt19937 rng(Seed);
+    std::vector<uint8_t> image(0x100000);
+    for (uint8_t& byte : image)
+        byte = rng();
+
+    GameBoy::RawCartridgeHeader *header =
+        reinterpret_cast<GameBoy::RawCartridgeHeader*>(&image[0x100]);
+    std::copy(GameBoy::NintendoLogo, GameBoy::NintendoLogo + sizeof(GameBoy::NintendoLogo), header->logo);
+    std::fill(header->title, header->title + sizeof(header->title), 'B');
+    header->cartridgeType = 0x01;
+    header->romSize = 0x05;
+    header->ramSize = 0x00;
+
+    char path[] = "/tmp/gbemu-bench-XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0 || write(fd, image.data(), image.size()) != (ssize_t) image.size()) {
+        std::cerr << "Cannot write the benchmark cartridge" << std::endl;
+        return;
+    }
+    close(fd);
+
+    Measure("cartridge.open", iterations, [&](uint64_t n) {
+        for (uint64_t i = 0; i < n; i++) {
+            GameBoy::Cartridge cartridge(path);
+            sink = cartridge.NumberOfROMBanks();
+        }
+    });
+
+    unlink(path);
+}
+
+int main(int argc, char *argv[])
+{
+    /* Scale every iteration count, e.g. 0.1 for a quick run */
+    double scale = (argc == 2) ? std::atof(argv[1]) : 1.0;
+    if (scale <= 0) {
+        std::cout << "usage: ./Bench [scale]" << std::endl;
+        return 0;
+    }
+
+    auto count = [scale](uint64_t n) { return std::max<uint64_t>(1, n * scale); };
+
+    for (const char *kind : { "alu", "load", "branch", "cb" })
+        BenchStep(kind, count(10000000));
+
+    BenchMemory(count(10000000));
+    BenchDisassemble(count(1000000));
+    BenchCartridgeOpen(count(200));
+
+    return 0;
+}
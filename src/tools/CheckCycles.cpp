@@ -0,0 +1,81 @@
+#include <cstdio>
+
+#include "cpu/CPU.hpp"
+#include "cpu/Instruction.hpp"
+#include "memory/MemoryMap.hpp"
+
+/**
+ * Steps every opcode once with the condition flags clear and once with them
+ * set, and checks the cycles it took against the instruction tables, so the
+ * tables generated from scripts/opcodes.json and the interpreter cannot drift
+ * apart unnoticed. Run by make test.
+ */
+
+static const uint16_t CodeAddress = 0xC000;
+static const uint16_t StackAddress = 0xDFF0;
+/* Far from CodeAddress so that a taken branch never lands on the next instruction */
+static const uint16_t ReturnAddress = 0x1234;
+
+static bool CheckOpcode(GameBoy::MemoryMap& mmap, GameBoy::CPU& cpu, bool isCB, uint8_t opcode, uint8_t flags)
+{
+    const GameBoy::AbstractInstruction& entry =
+        isCB ? GameBoy::InstructionTableCB[opcode] : GameBoy::InstructionTable[opcode];
+
+    uint8_t code[GameBoy::Instruction::MaxLength] = { opcode, 0x10, 0x20 };
+    if (isCB) {
+        code[0] = 0xCB;
+        code[1] = opcode;
+    }
+    mmap.Write(CodeAddress, code, sizeof(code));
+    mmap.WriteHalfWord(StackAddress, ReturnAddress);
+
+    cpu.Reset();
+    GameBoy::Registers& registers = cpu.GetRegisters();
+    registers.SetAF(flags);
+    /* (BC), (DE) and (HL) in WRAM, away from the code and the stack */
+    registers.SetBC(0xC100);
+    registers.SetDE(0xC200);
+    registers.SetHL(0xC300);
+    registers.sp = StackAddress;
+    cpu.SetPC(CodeAddress);
+
+    uint64_t cycles = cpu.Step();
+
+    bool taken = cpu.GetPC() != CodeAddress + entry.GetLength();
+    uint64_t expected = entry.IsConditional() && taken ? entry.GetCyclesTaken() : entry.GetCycles();
+    if (cycles == expected)
+        return true;
+
+    char mnemonic[GameBoy::Instruction::MaxStringLength];
+    GameBoy::Instruction::Decode(code).Disassemble(mnemonic, sizeof(mnemonic));
+    std::printf("%s%02X %-14s F=%02X: %llu cycles, the table says %llu\n",
+        isCB ? "CB " : "", opcode, mnemonic, flags,
+        static_cast<unsigned long long>(cycles), static_cast<unsigned long long>(expected));
+    return false;
+}
+
+int main(void)
+{
+    GameBoy::MemoryMap mmap;
+    GameBoy::CPU cpu(mmap);
+    size_t mismatches = 0, checked = 0;
+
+    for (int isCB = 0; isCB < 2; isCB++) {
+        for (unsigned int opcode = 0; opcode < 0x100; opcode++) {
+            const GameBoy::AbstractInstruction& entry =
+                isCB ? GameBoy::InstructionTableCB[opcode] : GameBoy::InstructionTable[opcode];
+            if (entry.GetBranchKind() == GameBoy::BranchIllegal || (!isCB && opcode == 0xCB))
+                continue;
+
+            /* Every condition is false one way and true the other */
+            for (uint8_t flags : { 0x00, 0xF0 }) {
+                if (!CheckOpcode(mmap, cpu, isCB, opcode, flags))
+                    mismatches++;
+                checked++;
+            }
+        }
+    }
+
+    std::printf("%zu/%zu opcode runs take the cycles of the tables\n", checked - mismatches, checked);
+    return mismatches ? 1 : 0;
+}
@@ -0,0 +1,110 @@
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <utility>
+
+#include "System.hpp"
+#include "SerialLink.hpp"
+
+/**
+ * Links two instances with a LocalSerialLink, each on its own thread, and has
+ * them exchange a byte with every combination of waiting for the transfer by
+ * polling SC and by HALT, so that the link syncs are known to happen on time
+ * even when the CPU sleeps through them. Run by make test.
+ */
+
+static const uint64_t CycleLimit = 1000000;
+static const uint16_t ResultAddress = 0xC000;
+
+static const uint8_t MasterByte = 0x42;
+static const uint8_t SlaveByte = 0x99;
+
+/* Sends byte with SC set to control, waits and stores what came in at ResultAddress */
+static void Assemble(uint8_t *rom, uint8_t byte, uint8_t control, bool halt)
+{
+    const uint8_t start[] = {
+        0xAF,               /* XOR A */
+        0xE0, 0x0F,         /* LDH (IF),A */
+        0x3E, 0x08,         /* LD A,0x08 */
+        0xE0, 0xFF,         /* LDH (IE),A, serial only */
+        0x3E, byte,         /* LD A,byte */
+        0xE0, 0x01,         /* LDH (SB),A */
+        0x3E, control,      /* LD A,control */
+        0xE0, 0x02,         /* LDH (SC),A */
+    };
+    /* With IME=0 the serial interrupt ends HALT without being serviced */
+    const uint8_t haltWait[] = {
+        0x76,               /* HALT */
+        0x00, 0x00, 0x00, 0x00,
+    };
+    const uint8_t pollWait[] = {
+        0xF0, 0x02,         /* LDH A,(SC) */
+        0x87,               /* ADD A,A, bit 7 to carry */
+        0x38, 0xFB,         /* JR C,-5 */
+    };
+    const uint8_t end[] = {
+        0xF0, 0x01,         /* LDH A,(SB) */
+        0xEA, ResultAddress & 0xFF, ResultAddress >> 8,
+        0x10, 0x00,         /* STOP */
+    };
+
+    uint8_t *code = rom + 0x0100;
+    for (uint8_t b : start)
+        *code++ = b;
+    const uint8_t *wait = halt ? haltWait : pollWait;
+    for (size_t i = 0; i < sizeof(pollWait); i++)
+        *code++ = wait[i];
+    for (uint8_t b : end)
+        *code++ = b;
+}
+
+/* Runs until STOP, then lets the other end run alone */
+static void RunEnd(GameBoy::System *system, std::unique_ptr<GameBoy::LocalSerialLink> link)
+{
+    GameBoy::CPU& cpu = system->GetCPU();
+
+    system->GetSerial().SetLink(link.get());
+    while (cpu.GetStatus() != GameBoy::CPU::StatusStopped && cpu.GetCycles() < CycleLimit)
+        cpu.Run(CycleLimit - cpu.GetCycles());
+    system->GetSerial().SetLink(nullptr);
+}
+
+static bool CheckExchange(bool masterHalts, bool slaveHalts)
+{
+    static uint8_t masterROM[0x8000], slaveROM[0x8000];
+    Assemble(masterROM, MasterByte, 0x81, masterHalts);
+    Assemble(slaveROM, SlaveByte, 0x80, slaveHalts);
+
+    GameBoy::System master, slave;
+    master.MapBlob(masterROM, sizeof(masterROM));
+    slave.MapBlob(slaveROM, sizeof(slaveROM));
+
+    auto links = GameBoy::LocalSerialLink::CreatePair();
+    std::thread masterThread(RunEnd, &master, std::move(links.first));
+    std::thread slaveThread(RunEnd, &slave, std::move(links.second));
+    masterThread.join();
+    slaveThread.join();
+
+    uint8_t masterIn = master.GetMemoryMap().LoadByte(ResultAddress);
+    uint8_t slaveIn = slave.GetMemoryMap().LoadByte(ResultAddress);
+    bool stopped = master.GetCPU().GetStatus() == GameBoy::CPU::StatusStopped
+        && slave.GetCPU().GetStatus() == GameBoy::CPU::StatusStopped;
+
+    bool ok = stopped && masterIn == SlaveByte && slaveIn == MasterByte;
+    std::printf("master %s, slave %s: master got %02X, slave got %02X%s\n",
+        masterHalts ? "halting" : "polling", slaveHalts ? "halting" : "polling",
+        masterIn, slaveIn, ok ? "" : (stopped ? ", wrong" : ", never completed"));
+    return ok;
+}
+
+int main(void)
+{
+    size_t failures = 0;
+
+    for (bool masterHalts : { false, true })
+        for (bool slaveHalts : { false, true })
+            if (!CheckExchange(masterHalts, slaveHalts))
+                failures++;
+
+    return failures ? 1 : 0;
+}
@@ -3,20 +3,234 @@
 #include <cstdio>
 #include <vector>
 #include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <string>
 
-#include "cpu/CPU.hpp"
-#include "memory/MemoryMap.hpp"
-#include "Video.hpp"
+#include "System.hpp"
+#include "Boot.hpp"
+#include "InputMovie.hpp"
+#include "audio/WaveWriter.hpp"
+#include "debug/Debugger.hpp"
+#include "debug/GDBServer.hpp"
+#include "trace/Trace.hpp"
+#include "trace/Replay.hpp"
+
+static void Usage(void)
+{
+    std::cout << "usage: ./LoadBlob [-c] [-B <boot ROM> | -f] [-t <trace file> [-z]] [-p <profile file>] [-m <report file>] [-a <wav file>] [-v <video file>]" << std::endl;
+    std::cout << "                  [-o <serial file>] [-L <socket path> | -l <socket path>] [-i <input movie>] [-r <input movie>]" << std::endl;
+    std::cout << "                  [-H <replay file> [-e <frames>] | -V <replay file>]" << std::endl;
+    std::cout << "                  [-n <cycles>] [-b <address>]... [-w <address>]... [-g <port|socket path>] <blob file>" << std::endl;
+    std::cout << "  -c  run in CGB mode" << std::endl;
+    std::cout << "  -B  start from this boot ROM, mapped over the blob until it writes 0xFF50" << std::endl;
+    std::cout << "  -f  start at 0x0100 from the state the boot ROM leaves, instead of at 0x0000" << std::endl;
+    std::cout << "  -t  run at full speed and record an execution trace" << std::endl;
+    std::cout << "  -z  compress the trace" << std::endl;
+    std::cout << "  -p  run at full speed and save an execution profile (make PROFILE=1)" << std::endl;
+    std::cout << "  -m  run at full speed and write a memory access report (make PROFILE=1)" << std::endl;
+    std::cout << "  -a  run at full speed and record the audio output, no audio is synthesized otherwise" << std::endl;
+    std::cout << "  -v  run at full speed and record raw 160x144 RGB24 frames" << std::endl;
+    std::cout << "  -o  run at full speed and save everything sent over the serial port" << std::endl;
+    std::cout << "  -L  run at full speed, linked to the instance connecting to this Unix socket" << std::endl;
+    std::cout << "  -l  run at full speed, linked to the instance listening on this Unix socket" << std::endl;
+    std::cout << "  -i  run at full speed and play the joypad input from this movie" << std::endl;
+    std::cout << "  -r  record the joypad input of interactive mode to this movie" << std::endl;
+    std::cout << "  -H  run at full speed and record a hash of the registers and memory every frame" << std::endl;
+    std::cout << "  -e  record the hash every this many frames instead" << std::endl;
+    std::cout << "  -V  run at full speed and stop at the first hash differing from this replay file" << std::endl;
+    std::cout << "  -n  stop after this many cycles" << std::endl;
+    std::cout << "  -b  break at this address in interactive mode, repeatable" << std::endl;
+    std::cout << "  -w  break on writes to this address in interactive mode, repeatable" << std::endl;
+    std::cout << "  -g  serve a GDB client on this localhost TCP port or Unix socket instead" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Interactive mode: return steps, c continues to the next break, q quits," << std::endl;
+    std::cout << "j <hex mask> sets the pressed buttons, Right Left Up Down A B Select Start from bit 0" << std::endl;
+}
+
+#ifdef GBEMU_PROFILE
+/* Closes a bucket of the memory access histogram every frame */
+class FrameMarker : public GameBoy::Schedulable
+{
+private:
+    static const uint64_t FrameCycles = 70224;
+
+    GameBoy::Scheduler& scheduler;
+    GameBoy::AccessCounters& counters;
+    int eventId;
+
+public:
+    FrameMarker(GameBoy::Scheduler& scheduler, GameBoy::AccessCounters& counters)
+    : scheduler(scheduler), counters(counters)
+    {
+        this->eventId = this->scheduler.Register(this);
+        this->scheduler.Schedule(this->eventId, FrameCycles);
+    }
+
+    ~FrameMarker()
+    {
+        this->scheduler.Cancel(this->eventId);
+    }
+
+    void OnEvent(uint64_t deadline)
+    {
+        this->counters.EndFrame();
+        this->scheduler.Schedule(this->eventId, deadline + FrameCycles);
+    }
+};
+#endif
+
+/* Records the audio, finishing the APU before the file is closed however the run ends */
+class AudioRecorder
+{
+private:
+    GameBoy::APU& apu;
+    GameBoy::WaveWriter writer;
+
+public:
+    AudioRecorder(GameBoy::APU& apu, const std::string& path, GameBoy::AudioRing& ring)
+    : apu(apu), writer(path, ring)
+    {
+    }
+
+    ~AudioRecorder()
+    {
+        this->apu.Finish();
+        this->writer.Close();
+    }
+};
+
+/* Appends every frame to a raw video file, on the render thread */
+class RawVideoWriter : public GameBoy::FrameSink
+{
+private:
+    FILE *file;
+    std::vector<uint8_t> rgb;
+
+public:
+    RawVideoWriter(const char *path) : rgb(GameBoy::Video::Width * GameBoy::Video::Height * 3)
+    {
+        this->file = std::fopen(path, "wb");
+        if (!this->file)
+            throw std::runtime_error("Cannot open video file");
+    }
+
+    ~RawVideoWriter()
+    {
+        std::fclose(this->file);
+    }
+
+    void OnFrame(const uint32_t *pixels, uint64_t)
+    {
+        for (size_t i = 0; i < this->rgb.size() / 3; i++) {
+            this->rgb[i * 3] = pixels[i] >> 16;
+            this->rgb[i * 3 + 1] = pixels[i] >> 8;
+            this->rgb[i * 3 + 2] = pixels[i];
+        }
+        std::fwrite(this->rgb.data(), 1, this->rgb.size(), this->file);
+    }
+};
+
+/**
+ * Runs until STOP, the cycle limit or a replay divergence, recording every
+ * executed instruction to trace if any
+ */
+static void RunBatch(GameBoy::CPU& cpu, GameBoy::MemoryMap& mmap,
+                     GameBoy::TraceWriter *trace, const GameBoy::ReplayLog *replay, uint64_t limit)
+{
+    GameBoy::TraceRecord record;
+
+    while (cpu.GetStatus() != GameBoy::CPU::StatusStopped && cpu.GetCycles() < limit
+           && !(replay && replay->HasDiverged())) {
+        if (trace && cpu.WillExecuteInstruction()) {
+            record.cycles = cpu.GetCycles();
+            record.SetRegisters(cpu.GetRegisters());
+            mmap.Peek(record.pc, record.bytecode, sizeof(record.bytecode));
+            trace->Append(record);
+        }
+        cpu.Step();
+    }
+}
 
 int main(int argc, char *argv[])
 {
-    if (argc != 2) {
-        std::cout << "usage: ./LoadBlob <blob file>" << std::endl;
+    const char *tracePath = nullptr;
+    const char *profilePath = nullptr;
+    const char *reportPath = nullptr;
+    const char *gdbAddress = nullptr;
+    const char *audioPath = nullptr;
+    const char *videoPath = nullptr;
+    const char *serialPath = nullptr;
+    const char *listenPath = nullptr;
+    const char *connectPath = nullptr;
+    const char *moviePath = nullptr;
+    const char *recordPath = nullptr;
+    const char *replayPath = nullptr;
+    const char *verifyPath = nullptr;
+    const char *bootPath = nullptr;
+    uint32_t replayInterval = 1;
+    std::vector<uint16_t> breakpoints, watchpoints;
+    bool compress = false;
+    bool color = false;
+    bool fastBoot = false;
+    uint64_t limit = UINT64_MAX;
+    int i;
+
+    for (i = 1; i < argc - 1; i++) {
+        std::string option(argv[i]);
+        if (option == "-t" && i + 1 < argc - 1)
+            tracePath = argv[++i];
+        else if (option == "-p" && i + 1 < argc - 1)
+            profilePath = argv[++i];
+        else if (option == "-m" && i + 1 < argc - 1)
+            reportPath = argv[++i];
+        else if (option == "-a" && i + 1 < argc - 1)
+            audioPath = argv[++i];
+        else if (option == "-v" && i + 1 < argc - 1)
+            videoPath = argv[++i];
+        else if (option == "-o" && i + 1 < argc - 1)
+            serialPath = argv[++i];
+        else if (option == "-L" && i + 1 < argc - 1)
+            listenPath = argv[++i];
+        else if (option == "-l" && i + 1 < argc - 1)
+            connectPath = argv[++i];
+        else if (option == "-i" && i + 1 < argc - 1)
+            moviePath = argv[++i];
+        else if (option == "-r" && i + 1 < argc - 1)
+            recordPath = argv[++i];
+        else if (option == "-H" && i + 1 < argc - 1)
+            replayPath = argv[++i];
+        else if (option == "-e" && i + 1 < argc - 1)
+            replayInterval = std::strtoul(argv[++i], nullptr, 0);
+        else if (option == "-V" && i + 1 < argc - 1)
+            verifyPath = argv[++i];
+        else if (option == "-z")
+            compress = true;
+        else if (option == "-c")
+            color = true;
+        else if (option == "-B" && i + 1 < argc - 1)
+            bootPath = argv[++i];
+        else if (option == "-f")
+            fastBoot = true;
+        else if (option == "-n" && i + 1 < argc - 1)
+            limit = std::strtoull(argv[++i], nullptr, 0);
+        else if (option == "-b" && i + 1 < argc - 1)
+            breakpoints.push_back(std::strtoul(argv[++i], nullptr, 16));
+        else if (option == "-w" && i + 1 < argc - 1)
+            watchpoints.push_back(std::strtoul(argv[++i], nullptr, 16));
+        else if (option == "-g" && i + 1 < argc - 1)
+            gdbAddress = argv[++i];
+        else
+            break;
+    }
+
+    if (i != argc - 1 || (replayPath && verifyPath) || (bootPath && fastBoot)) {
+        Usage();
         return 0;
     }
 
     std::ifstream handler;
-    handler.open(argv[1], std::ifstream::ate | std::ifstream::binary);
+    handler.open(argv[i], std::ifstream::ate | std::ifstream::binary);
     if (handler.fail()) {
         std::cerr << "Blob file not found" << std::endl;
         return -1;
@@ -30,31 +244,218 @@ int main(int argc, char *argv[])
     handler.read(reinterpret_cast<char*>(contents), size);
     handler.close();
 
-    /* Initialize emulator */
-    GameBoy::MemoryMap mmap;
-    GameBoy::CPU cpu(mmap);
-    GameBoy::Video video(mmap);
+    /* Initialize emulator, headless unless the video or the audio is recorded */
+    GameBoy::AudioRing audioRing(1 << 14);
+    GameBoy::System system(color, videoPath != nullptr, audioPath ? &audioRing : nullptr);
+    GameBoy::MemoryMap& mmap = system.GetMemoryMap();
+    GameBoy::CPU& cpu = system.GetCPU();
+    GameBoy::Video& video = system.GetVideo();
+    GameBoy::Serial& serial = system.GetSerial();
+    GameBoy::Joypad& joypad = system.GetJoypad();
 
-    mmap.AddSegment(new GameBoy::MemorySegment(
-        "ROM", 0x0000, size, 
-        GameBoy::MemorySegment::Permissions::ReadWrite, 
-        contents));
+    system.MapBlob(contents, size);
     cpu.SetPC(0x0000);
 
-    /*std::vector<uint16_t> bps;
-    bps.push_back(0x000C);*/
-    
-    while (cpu.GetStatus() == GameBoy::CPU::StatusRunning) {
-        //if (std::find(bps.begin(), bps.end(), cpu.GetPC()) != bps.end())
-        //    break;
-        cpu.Dump();
-        cpu.Step();
-        std::getchar();
+    std::unique_ptr<GameBoy::BootROM> boot;
+    try {
+        if (bootPath) {
+            boot.reset(new GameBoy::BootROM(mmap, bootPath));
+            if (boot->IsColor() != color)
+                throw std::runtime_error(color ? "Not a CGB boot ROM" : "Not a DMG boot ROM, use -c for CGB ones");
+        } else if (fastBoot) {
+            GameBoy::FastBoot(mmap, cpu, system.GetTimer(), color);
+        }
+    } catch (std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        delete [] contents;
+        return -1;
     }
 
-    while (cpu.GetStatus() == GameBoy::CPU::StatusRunning) {
+#ifndef GBEMU_PROFILE
+    if (profilePath || reportPath) {
+        std::cerr << "Profiling is not built in, rebuild with make PROFILE=1" << std::endl;
+        delete [] contents;
+        return -1;
+    }
+#endif
+
+    if (tracePath || profilePath || reportPath || audioPath || videoPath
+        || serialPath || listenPath || connectPath || moviePath || replayPath || verifyPath) {
+        try {
+            std::unique_ptr<GameBoy::ReplayLog> replay;
+            if (replayPath)
+                replay.reset(new GameBoy::ReplayLog(mmap, cpu, system.GetMemoryBanks(), replayPath, GameBoy::ReplayLog::ModeRecord, replayInterval));
+            else if (verifyPath)
+                replay.reset(new GameBoy::ReplayLog(mmap, cpu, system.GetMemoryBanks(), verifyPath, GameBoy::ReplayLog::ModeVerify));
+
+            std::unique_ptr<GameBoy::InputMovieReader> movie;
+            if (moviePath) {
+                movie.reset(new GameBoy::InputMovieReader(moviePath));
+                joypad.SetMovie(movie.get());
+            }
+
+            std::unique_ptr<GameBoy::SerialLink> link;
+            if (listenPath)
+                link = GameBoy::SocketSerialLink::Listen(listenPath);
+            else if (connectPath)
+                link = GameBoy::SocketSerialLink::Connect(connectPath);
+            serial.SetLink(link.get());
+
+            std::unique_ptr<RawVideoWriter> frames;
+            if (videoPath) {
+                frames.reset(new RawVideoWriter(videoPath));
+                video.SetFrameSink(frames.get());
+            }
+
+            std::unique_ptr<AudioRecorder> audio;
+            if (audioPath)
+                audio.reset(new AudioRecorder(system.GetAPU(), audioPath, audioRing));
+
+#ifdef GBEMU_PROFILE
+            /* Counters for every PC don't belong on the stack */
+            std::unique_ptr<GameBoy::Profiler> profiler(new GameBoy::Profiler());
+            if (profilePath)
+                cpu.SetProfiler(profiler.get());
+
+            std::unique_ptr<GameBoy::AccessCounters> counters(new GameBoy::AccessCounters());
+            std::unique_ptr<FrameMarker> frameMarker;
+            if (reportPath) {
+                mmap.SetAccessCounters(counters.get());
+                frameMarker.reset(new FrameMarker(cpu.GetScheduler(), *counters));
+            }
+#endif
+
+            if (tracePath) {
+                GameBoy::TraceWriter trace(tracePath, compress);
+                RunBatch(cpu, mmap, &trace, replay.get(), limit);
+            } else {
+                RunBatch(cpu, mmap, nullptr, replay.get(), limit);
+            }
+
+            joypad.SetMovie(nullptr);
+
+            /* Lets the other end know it runs alone from now on */
+            serial.SetLink(nullptr);
+            link.reset();
+
+            if (serialPath) {
+                std::ofstream output(serialPath, std::ofstream::binary);
+                output << serial.GetOutput();
+            }
+
+            audio.reset();
+
+            if (frames) {
+                video.Finish();
+                video.SetFrameSink(nullptr);
+            }
+
+#ifdef GBEMU_PROFILE
+            /* Reading the bytecode for the profile is no access of the run */
+            mmap.SetAccessCounters(nullptr);
+
+            if (profilePath)
+                profiler->Save(profilePath, mmap);
+
+            if (reportPath) {
+                FILE *report = std::fopen(reportPath, "w");
+                if (!report)
+                    throw std::runtime_error("Cannot open report file");
+                counters->Report(report, mmap);
+                std::fclose(report);
+            }
+#endif
+
+            if (verifyPath && replay->HasDiverged()) {
+                const GameBoy::ReplayCheckpoint& expected = replay->GetExpected();
+                const GameBoy::ReplayCheckpoint& actual = replay->GetActual();
+                printf("Diverged at frame %llu: cycle %llu hash %016llx, recorded cycle %llu hash %016llx\n",
+                    (unsigned long long) actual.frame,
+                    (unsigned long long) actual.cycles, (unsigned long long) actual.hash,
+                    (unsigned long long) expected.cycles, (unsigned long long) expected.hash);
+                delete [] contents;
+                return 1;
+            } else if (verifyPath) {
+                printf("%zu checkpoints matched%s\n", replay->GetCheckpoints(),
+                    replay->AtEnd() ? "" : ", the replay file goes on");
+            }
+        } catch (std::exception& e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+            delete [] contents;
+            return -1;
+        }
+
+        delete [] contents;
+        return 0;
+    }
+
+    GameBoy::Debugger debugger(mmap, cpu);
+    for (uint16_t address : breakpoints)
+        debugger.AddBreakpoint(address);
+    for (uint16_t address : watchpoints)
+        debugger.AddWatchpoint(address, address + 1, GameBoy::Watchpoint::WatchWrite);
+
+    if (gdbAddress) {
+        try {
+            GameBoy::GDBServer server(mmap, cpu, debugger);
+
+            /* All digits is a TCP port, anything else a socket path */
+            std::string address(gdbAddress);
+            if (address.find_first_not_of("0123456789") == std::string::npos)
+                server.ListenTCP(std::strtoul(gdbAddress, nullptr, 10));
+            else
+                server.ListenUnix(address);
+
+            server.Serve();
+        } catch (std::exception& e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+            delete [] contents;
+            return -1;
+        }
+
+        delete [] contents;
+        return 0;
+    }
+
+    std::unique_ptr<GameBoy::InputMovieWriter> recorder;
+    if (recordPath) {
+        try {
+            recorder.reset(new GameBoy::InputMovieWriter(recordPath));
+        } catch (std::exception& e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+            delete [] contents;
+            return -1;
+        }
+        joypad.SetRecorder(recorder.get());
+    }
+
+    std::string command;
+    while (cpu.GetStatus() != GameBoy::CPU::StatusStopped) {
         cpu.Dump();
-        cpu.Step();
+        if (!std::getline(std::cin, command) || command == "q")
+            break;
+
+        if (command.compare(0, 2, "j ") == 0) {
+            joypad.SetButtons(std::strtoul(command.c_str() + 2, nullptr, 16));
+            continue;
+        }
+
+        if (command != "c") {
+            cpu.Step();
+            continue;
+        }
+
+        /* One frame at a time until something breaks */
+        do {
+            cpu.Run(70224);
+        } while (!debugger.IsStopRequested() && cpu.GetStatus() != GameBoy::CPU::StatusStopped);
+
+        if (debugger.GetStopReason() == GameBoy::Debugger::StopWatchpoint) {
+            const GameBoy::Debugger::WatchHit& hit = debugger.GetWatchHit();
+            printf("Watchpoint: %02X written to %04X\n", hit.value, hit.address);
+        } else if (debugger.GetStopReason() == GameBoy::Debugger::StopBreakpoint) {
+            printf("Breakpoint at %04X\n", cpu.GetPC());
+        }
     }
 
     delete [] contents;
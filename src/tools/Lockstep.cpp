@@ -0,0 +1,175 @@
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "System.hpp"
+#include "Boot.hpp"
+#include "trace/ReferenceTrace.hpp"
+
+static void Usage(void)
+{
+    std::cout << "usage: ./Lockstep [-n <instructions>] [-c <context>] <rom file> <reference trace>" << std::endl;
+    std::cout << "  -n  stop after this many instructions" << std::endl;
+    std::cout << "  -c  number of instructions shown around a divergence (default 8)" << std::endl;
+    std::cout << std::endl;
+    std::cout << "The reference is either a gameboy-doctor log, in which case the ROM starts" << std::endl;
+    std::cout << "from the DMG post-boot state at 0x0100 with LY stuck at 0x90, or a binary" << std::endl;
+    std::cout << "trace recorded with LoadBlob -t, in which case it starts like LoadBlob." << std::endl;
+}
+
+static void PrintState(const GameBoy::TraceRecord& state, const uint8_t *pcmem, bool withCycles)
+{
+    char line[GameBoy::ReferenceTrace::DoctorLineLength + 1];
+    GameBoy::ReferenceTrace::FormatDoctorLine(state, pcmem, line);
+
+    if (withCycles) {
+        line[GameBoy::ReferenceTrace::DoctorLineLength - 3] = '\0';
+        std::printf("%s CYCLES:%llu\n", line, static_cast<unsigned long long>(state.cycles));
+    } else {
+        line[GameBoy::ReferenceTrace::DoctorLineLength] = '\0';
+        std::printf("%s\n", line);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    uint64_t limit = UINT64_MAX;
+    size_t context = 8;
+    int i;
+
+    for (i = 1; i < argc - 2; i++) {
+        std::string option(argv[i]);
+        if (option == "-n" && i + 1 < argc - 2)
+            limit = std::strtoull(argv[++i], nullptr, 0);
+        else if (option == "-c" && i + 1 < argc - 2)
+            context = std::strtoul(argv[++i], nullptr, 0);
+        else
+            break;
+    }
+
+    if (i != argc - 2) {
+        Usage();
+        return 0;
+    }
+
+    std::ifstream handler;
+    handler.open(argv[i], std::ifstream::ate | std::ifstream::binary);
+    if (handler.fail()) {
+        std::cerr << "ROM file not found" << std::endl;
+        return -1;
+    }
+
+    /* Mapped whole like LoadBlob does, for its traces to replay the same */
+    uint32_t size = handler.tellg();
+    handler.seekg(0);
+
+    std::vector<uint8_t> contents(size);
+    handler.read(reinterpret_cast<char*>(contents.data()), size);
+    handler.close();
+
+    try {
+        GameBoy::ReferenceTrace reference(argv[i + 1]);
+        bool isDoctor = reference.GetFormat() == GameBoy::ReferenceTrace::FormatDoctor;
+
+        /* Initialize emulator */
+        GameBoy::System system;
+        GameBoy::MemoryMap& mmap = system.GetMemoryMap();
+        GameBoy::CPU& cpu = system.GetCPU();
+        system.MapBlob(contents.data(), size);
+
+        /* gameboy-doctor expects LY to always read 0x90, whatever the PPU says */
+        uint8_t ly = 0x90;
+        GameBoy::MemorySegment lySegment(
+            "LY", 0xFF44, 0xFF45,
+            GameBoy::MemorySegment::Permissions::Read,
+            &ly);
+
+        if (isDoctor) {
+            mmap.InsertSegment(&lySegment);
+
+            GameBoy::FastBoot(mmap, cpu, system.GetTimer(), false);
+            /* Logs assume a valid header checksum, whatever the ROM holds */
+            cpu.GetRegisters().SetAF(0x01B0);
+        } else {
+            cpu.SetPC(0x0000);
+        }
+
+        /* Last matching states, printed as context on divergence */
+        std::vector<GameBoy::TraceRecord> history(context);
+        std::vector<std::array<uint8_t, 4>> historyMemory(context);
+
+        GameBoy::TraceRecord state;
+        uint8_t pcmem[4];
+        uint64_t n = 0;
+
+        auto start = std::chrono::steady_clock::now();
+
+        while (n < limit && !reference.AtEnd()) {
+            if (cpu.GetStatus() == GameBoy::CPU::StatusStopped)
+                break;
+
+            /* Interrupt dispatch and HALT are not instructions of the log */
+            if (!cpu.WillExecuteInstruction()) {
+                cpu.Step();
+                continue;
+            }
+
+            state.cycles = cpu.GetCycles();
+            state.SetRegisters(cpu.GetRegisters());
+            for (uint16_t j = 0; j < sizeof(pcmem); j++)
+                pcmem[j] = mmap.LoadByte(state.pc + j);
+            std::copy(pcmem, pcmem + sizeof(state.bytecode), state.bytecode);
+
+            if (!reference.Compare(state, pcmem)) {
+                std::printf("Divergence at instruction %llu\n\n", static_cast<unsigned long long>(n));
+
+                size_t shown = std::min<uint64_t>(n, context);
+                for (size_t j = shown; j > 0; j--) {
+                    size_t slot = (n - j) % context;
+                    PrintState(history[slot], historyMemory[slot].data(), !isDoctor);
+                }
+
+                std::printf("\nreference:\n");
+                for (size_t j = 0; j < std::max<size_t>(context, 1); j++) {
+                    if (!reference.PrintEntry(stdout, j))
+                        break;
+                }
+
+                std::printf("\nemulator:\n");
+                PrintState(state, pcmem, !isDoctor);
+                return 1;
+            }
+
+            if (context) {
+                history[n % context] = state;
+                std::copy(pcmem, pcmem + sizeof(pcmem), historyMemory[n % context].begin());
+            }
+
+            cpu.Step();
+            n++;
+        }
+
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        if (n < limit && !reference.AtEnd()) {
+            std::printf("Emulator stopped after %llu instructions, reference continues with:\n",
+                        static_cast<unsigned long long>(n));
+            reference.PrintEntry(stdout, 0);
+            return 1;
+        }
+
+        std::printf("%llu instructions match (%.1f M/s)\n",
+                    static_cast<unsigned long long>(n), n / elapsed.count() / 1e6);
+    } catch (std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,116 @@
+#include <iostream>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cpu/Instruction.hpp"
+#include "cpu/Profiler.hpp"
+
+struct OpcodeEntry {
+    bool isCB;
+    uint8_t opcode;
+    GameBoy::Profiler::Counter counter;
+};
+
+/* Mnemonic with the immediate left symbolic, e.g. "LD A, n8" */
+static std::string GetMnemonic(const GameBoy::AbstractInstruction& instr)
+{
+    std::string mnemonic = instr.GetFormat();
+    static const char *patterns[][2] = {
+        { "0x%02X", "n8" }, { "0x%04X", "n16" }, { "%02X", "n8" }, { "%04X", "n16" },
+    };
+
+    for (auto& pattern : patterns) {
+        size_t position = mnemonic.find(pattern[0]);
+        if (position != std::string::npos)
+            mnemonic.replace(position, std::string(pattern[0]).size(), pattern[1]);
+    }
+
+    return mnemonic;
+}
+
+static double Percent(uint64_t value, uint64_t total)
+{
+    return total ? 100.0 * value / total : 0.0;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2 || argc > 3) {
+        std::cout << "usage: ./ProfileDump <profile file> [number of entries]" << std::endl;
+        return 0;
+    }
+
+    size_t limit = (argc == 3) ? std::strtoul(argv[2], nullptr, 0) : 32;
+
+    std::unique_ptr<GameBoy::Profiler> profiler(new GameBoy::Profiler());
+    std::vector<GameBoy::Profiler::AddressEntry> addresses;
+
+    try {
+        addresses = profiler->Load(argv[1]);
+    } catch (std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return -1;
+    }
+
+    std::vector<OpcodeEntry> opcodes;
+    uint64_t totalCycles = 0, totalExecutions = 0;
+
+    for (uint16_t i = 0; i < 256; i++) {
+        if (profiler->GetOpcode(i).executions && i != 0xCB)
+            opcodes.push_back({ false, (uint8_t) i, profiler->GetOpcode(i) });
+        if (profiler->GetOpcodeCB(i).executions)
+            opcodes.push_back({ true, (uint8_t) i, profiler->GetOpcodeCB(i) });
+    }
+
+    for (const OpcodeEntry& entry : opcodes) {
+        totalCycles += entry.counter.cycles;
+        totalExecutions += entry.counter.executions;
+    }
+
+    std::sort(opcodes.begin(), opcodes.end(), [](const OpcodeEntry& a, const OpcodeEntry& b) {
+        return a.counter.cycles > b.counter.cycles;
+    });
+    std::sort(addresses.begin(), addresses.end(),
+              [](const GameBoy::Profiler::AddressEntry& a, const GameBoy::Profiler::AddressEntry& b) {
+        return a.counter.cycles > b.counter.cycles;
+    });
+
+    std::printf("%llu instructions, %llu cycles\n\n",
+                static_cast<unsigned long long>(totalExecutions),
+                static_cast<unsigned long long>(totalCycles));
+
+    std::printf("Opcodes by cycles:\n");
+    std::printf("%14s %7s %14s  %-6s %s\n", "cycles", "%", "executions", "opcode", "mnemonic");
+    for (size_t i = 0; i < opcodes.size() && i < limit; i++) {
+        const OpcodeEntry& entry = opcodes[i];
+        const GameBoy::AbstractInstruction& instr = entry.isCB
+            ? GameBoy::InstructionTableCB[entry.opcode] : GameBoy::InstructionTable[entry.opcode];
+
+        std::printf("%14llu %6.2f%% %14llu  %s%02X  %s\n",
+                    static_cast<unsigned long long>(entry.counter.cycles),
+                    Percent(entry.counter.cycles, totalCycles),
+                    static_cast<unsigned long long>(entry.counter.executions),
+                    entry.isCB ? "CB" : "  ", entry.opcode, GetMnemonic(instr).c_str());
+    }
+
+    std::printf("\nAddresses by cycles:\n");
+    std::printf("%14s %7s %14s  %-4s   %s\n", "cycles", "%", "executions", "pc", "instruction");
+    for (size_t i = 0; i < addresses.size() && i < limit; i++) {
+        const GameBoy::Profiler::AddressEntry& entry = addresses[i];
+
+        char text[GameBoy::Instruction::MaxStringLength];
+        GameBoy::Instruction::Decode(entry.bytecode).Disassemble(text, sizeof(text));
+
+        std::printf("%14llu %6.2f%% %14llu  %04X   %s\n",
+                    static_cast<unsigned long long>(entry.counter.cycles),
+                    Percent(entry.counter.cycles, totalCycles),
+                    static_cast<unsigned long long>(entry.counter.executions),
+                    entry.pc, text);
+    }
+
+    return 0;
+}
@@ -0,0 +1,387 @@
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "System.hpp"
+#include "Boot.hpp"
+
+static void Usage(void)
+{
+    std::cout << "usage: ./TestRunner [-j <jobs>] [-n <cycles>] [-x <junit file>] [-J <json file>]" << std::endl;
+    std::cout << "                    [-b <DMG boot ROM>] [-c <CGB boot ROM>] <rom file>..." << std::endl;
+    std::cout << "  -j  number of ROMs run at once (default one per hardware thread)" << std::endl;
+    std::cout << "  -n  give up on a ROM after this many cycles (default 120 emulated seconds)" << std::endl;
+    std::cout << "  -x  write a JUnit XML report" << std::endl;
+    std::cout << "  -J  write a JSON report" << std::endl;
+    std::cout << "  -b  run the DMG ROMs through this boot ROM" << std::endl;
+    std::cout << "  -c  run the CGB ROMs through this boot ROM" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Every ROM runs headless from the post-boot state, or its boot ROM when given," << std::endl;
+    std::cout << "in CGB mode when its header asks for it, until it reports a result:" << std::endl;
+    std::cout << "\"Passed\" or \"Failed\" over the serial port (Blargg), the Fibonacci sequence" << std::endl;
+    std::cout << "3 5 8 13 21 34 or 0x42 six times over the serial port or in B C D E H L at a" << std::endl;
+    std::cout << "LD B,B breakpoint (Mooneye). Exits with 1 unless every ROM passed." << std::endl;
+}
+
+enum Outcome {
+    OutcomePassed,
+    OutcomeFailed,
+    OutcomeTimeout,
+    OutcomeError
+};
+
+static const char *OutcomeNames[] = { "passed", "failed", "timeout", "error" };
+
+struct TestResult {
+    std::string path;
+    Outcome outcome;
+    std::string detail;
+    std::string output;
+    uint64_t cycles;
+    double seconds;
+};
+
+/* Cartridge ROM, where writes go to the (missing) MBC and are dropped */
+class ROMSegment : public GameBoy::MemorySegment
+{
+public:
+    ROMSegment(uint8_t *memory)
+    : GameBoy::MemorySegment("ROM", 0x0000, 0x8000, GameBoy::MemorySegment::Permissions::Read, memory)
+    {
+    }
+
+    void Write(uint16_t, const uint8_t*, uint16_t) {}
+    void WriteByte(uint16_t, const uint8_t) {}
+};
+
+static const uint8_t LdBB = 0x40;
+static const uint8_t Fibonacci[] = { 3, 5, 8, 13, 21, 34 };
+static const uint8_t MooneyeFailure[] = { 0x42, 0x42, 0x42, 0x42, 0x42, 0x42 };
+
+/* Decides from the serial output so far, returns false while undecided */
+static bool CheckOutput(const std::string& output, TestResult& result)
+{
+    std::string fibonacci(Fibonacci, Fibonacci + sizeof(Fibonacci));
+    std::string failure(MooneyeFailure, MooneyeFailure + sizeof(MooneyeFailure));
+
+    if (output.find(fibonacci) != std::string::npos) {
+        result.outcome = OutcomePassed;
+        result.detail = "Fibonacci sequence over serial";
+    } else if (output.find(failure) != std::string::npos) {
+        result.outcome = OutcomeFailed;
+        result.detail = "0x42 sequence over serial";
+    } else if (output.find("Passed") != std::string::npos) {
+        result.outcome = OutcomePassed;
+        result.detail = "\"Passed\" over serial";
+    } else if (output.find("Failed") != std::string::npos) {
+        /* Blargg prints the failing test numbers on the same line */
+        if (output.find('\n', output.find("Failed")) == std::string::npos)
+            return false;
+        result.outcome = OutcomeFailed;
+        result.detail = "\"Failed\" over serial";
+    } else {
+        return false;
+    }
+
+    return true;
+}
+
+static void RunTest(const std::string& path, uint64_t limit, const char *const bootPaths[2], TestResult& result)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    result.path = path;
+    result.outcome = OutcomeError;
+    result.cycles = 0;
+    result.seconds = 0;
+
+    std::ifstream handler(path, std::ifstream::binary);
+    if (handler.fail()) {
+        result.detail = "ROM file not found";
+        return;
+    }
+
+    /* Only the first two banks are mapped, missing bytes read as an open bus */
+    std::vector<uint8_t> contents(0x8000, 0xFF);
+    handler.read(reinterpret_cast<char*>(contents.data()), contents.size());
+    handler.close();
+
+    /* CGB flag of the header */
+    bool color = contents[0x143] & 0x80;
+
+    GameBoy::System system(color);
+    GameBoy::MemoryMap& mmap = system.GetMemoryMap();
+    GameBoy::CPU& cpu = system.GetCPU();
+    GameBoy::Serial& serial = system.GetSerial();
+
+    ROMSegment rom(contents.data());
+    mmap.AddSegment(&rom);
+
+    std::unique_ptr<GameBoy::BootROM> boot;
+    if (bootPaths[color]) {
+        try {
+            boot.reset(new GameBoy::BootROM(mmap, bootPaths[color]));
+        } catch (std::exception& e) {
+            result.detail = e.what();
+            mmap.RemoveSegment(&rom);
+            return;
+        }
+
+        if (boot->IsColor() != color) {
+            result.detail = color ? "Not a CGB boot ROM" : "Not a DMG boot ROM";
+            mmap.RemoveSegment(&rom);
+            return;
+        }
+        cpu.SetPC(0x0000);
+    } else {
+        GameBoy::FastBoot(mmap, cpu, system.GetTimer(), color);
+    }
+
+    GameBoy::Registers& registers = cpu.GetRegisters();
+
+    size_t checked = 0;
+    bool done = false;
+
+    try {
+        while (!done) {
+            if (cpu.GetCycles() >= limit) {
+                result.outcome = OutcomeTimeout;
+                result.detail = "No result after " + std::to_string(limit) + " cycles";
+                break;
+            }
+
+            if (cpu.GetStatus() == GameBoy::CPU::StatusStopped) {
+                result.outcome = OutcomeFailed;
+                result.detail = "STOP executed";
+                break;
+            }
+
+            cpu.Step();
+
+            if (serial.GetOutput().size() != checked) {
+                checked = serial.GetOutput().size();
+                done = CheckOutput(serial.GetOutput(), result);
+            }
+
+            if (done || cpu.GetStatus() != GameBoy::CPU::StatusRunning
+                || mmap.LoadByte(cpu.GetPC()) != LdBB)
+                continue;
+
+            const uint8_t values[] = { registers.b, registers.c, registers.d,
+                                       registers.e, registers.h, registers.l };
+            done = true;
+            if (std::equal(values, values + sizeof(values), Fibonacci)) {
+                result.outcome = OutcomePassed;
+                result.detail = "Fibonacci registers at LD B,B";
+            } else if (std::equal(values, values + sizeof(values), MooneyeFailure)) {
+                result.outcome = OutcomeFailed;
+                result.detail = "0x42 registers at LD B,B";
+            } else {
+                char detail[64];
+                std::snprintf(detail, sizeof(detail),
+                    "LD B,B at %04X without a result in the registers", cpu.GetPC());
+                result.outcome = OutcomeFailed;
+                result.detail = detail;
+            }
+        }
+    } catch (std::exception& e) {
+        result.outcome = OutcomeError;
+        result.detail = e.what();
+    }
+
+    mmap.RemoveSegment(&rom);
+
+    result.output = serial.GetOutput();
+    result.cycles = cpu.GetCycles();
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/* Escapes text for XML, dropping what XML 1.0 cannot hold */
+static std::string EscapeXML(const std::string& text)
+{
+    std::string escaped;
+
+    for (unsigned char c : text) {
+        switch (c) {
+            case '<': escaped += "&lt;"; break;
+            case '>': escaped += "&gt;"; break;
+            case '&': escaped += "&amp;"; break;
+            case '"': escaped += "&quot;"; break;
+            default:
+                if (c >= 0x20 || c == '\n' || c == '\t')
+                    escaped += c;
+                break;
+        }
+    }
+
+    return escaped;
+}
+
+static std::string EscapeJSON(const std::string& text)
+{
+    std::string escaped;
+
+    for (unsigned char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+            escaped += c;
+        } else if (c < 0x20 || c >= 0x7F) {
+            char code[8];
+            std::snprintf(code, sizeof(code), "\\u%04x", c);
+            escaped += code;
+        } else {
+            escaped += c;
+        }
+    }
+
+    return escaped;
+}
+
+static void WriteJUnit(const char *path, const std::vector<TestResult>& results, double seconds)
+{
+    FILE *file = std::fopen(path, "w");
+    if (!file)
+        throw std::runtime_error("Cannot open JUnit report");
+
+    size_t failures = 0, errors = 0;
+    for (const TestResult& result : results) {
+        if (result.outcome == OutcomeFailed || result.outcome == OutcomeTimeout)
+            failures++;
+        else if (result.outcome == OutcomeError)
+            errors++;
+    }
+
+    std::fprintf(file, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+    std::fprintf(file, "<testsuite name=\"TestRunner\" tests=\"%zu\" failures=\"%zu\" errors=\"%zu\" time=\"%.3f\">\n",
+        results.size(), failures, errors, seconds);
+
+    for (const TestResult& result : results) {
+        std::fprintf(file, "  <testcase name=\"%s\" time=\"%.3f\">\n",
+            EscapeXML(result.path).c_str(), result.seconds);
+        std::fprintf(file, "    <properties><property name=\"cycles\" value=\"%llu\"/></properties>\n",
+            static_cast<unsigned long long>(result.cycles));
+
+        if (result.outcome == OutcomeError)
+            std::fprintf(file, "    <error message=\"%s\"/>\n", EscapeXML(result.detail).c_str());
+        else if (result.outcome != OutcomePassed)
+            std::fprintf(file, "    <failure type=\"%s\" message=\"%s\"/>\n",
+                OutcomeNames[result.outcome], EscapeXML(result.detail).c_str());
+
+        if (!result.output.empty())
+            std::fprintf(file, "    <system-out>%s</system-out>\n", EscapeXML(result.output).c_str());
+        std::fprintf(file, "  </testcase>\n");
+    }
+
+    std::fprintf(file, "</testsuite>\n");
+    std::fclose(file);
+}
+
+static void WriteJSON(const char *path, const std::vector<TestResult>& results, double seconds)
+{
+    FILE *file = std::fopen(path, "w");
+    if (!file)
+        throw std::runtime_error("Cannot open JSON report");
+
+    std::fprintf(file, "{\n  \"seconds\": %.3f,\n  \"results\": [\n", seconds);
+
+    for (size_t i = 0; i < results.size(); i++) {
+        const TestResult& result = results[i];
+        std::fprintf(file, "    {\"rom\": \"%s\", \"result\": \"%s\", \"detail\": \"%s\", "
+            "\"cycles\": %llu, \"seconds\": %.3f, \"output\": \"%s\"}%s\n",
+            EscapeJSON(result.path).c_str(), OutcomeNames[result.outcome],
+            EscapeJSON(result.detail).c_str(), static_cast<unsigned long long>(result.cycles),
+            result.seconds, EscapeJSON(result.output).c_str(),
+            i + 1 < results.size() ? "," : "");
+    }
+
+    std::fprintf(file, "  ]\n}\n");
+    std::fclose(file);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *junitPath = nullptr;
+    const char *jsonPath = nullptr;
+    unsigned int jobs = std::max(1u, std::thread::hardware_concurrency());
+    uint64_t limit = 120 * 4194304ULL;
+    /* DMG and CGB boot ROMs, fast boot when missing */
+    const char *bootPaths[2] = { nullptr, nullptr };
+    int i;
+
+    for (i = 1; i < argc; i++) {
+        std::string option(argv[i]);
+        if (option == "-j" && i + 1 < argc)
+            jobs = std::max(1ul, std::strtoul(argv[++i], nullptr, 0));
+        else if (option == "-n" && i + 1 < argc)
+            limit = std::strtoull(argv[++i], nullptr, 0);
+        else if (option == "-x" && i + 1 < argc)
+            junitPath = argv[++i];
+        else if (option == "-J" && i + 1 < argc)
+            jsonPath = argv[++i];
+        else if (option == "-b" && i + 1 < argc)
+            bootPaths[0] = argv[++i];
+        else if (option == "-c" && i + 1 < argc)
+            bootPaths[1] = argv[++i];
+        else
+            break;
+    }
+
+    if (i == argc || argv[i][0] == '-') {
+        Usage();
+        return 0;
+    }
+
+    std::vector<TestResult> results(argc - i);
+    std::atomic<size_t> next(0);
+    std::mutex printMutex;
+    auto start = std::chrono::steady_clock::now();
+
+    /* Every worker takes the next ROM until there are none left */
+    auto work = [&]() {
+        size_t index;
+        while ((index = next++) < results.size()) {
+            TestResult& result = results[index];
+            RunTest(argv[i + index], limit, bootPaths, result);
+
+            std::lock_guard<std::mutex> lock(printMutex);
+            std::printf("%-7s %s (%llu cycles, %.2fs): %s\n",
+                OutcomeNames[result.outcome], result.path.c_str(),
+                static_cast<unsigned long long>(result.cycles), result.seconds,
+                result.detail.c_str());
+            std::fflush(stdout);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    jobs = std::min<size_t>(jobs, results.size());
+    for (unsigned int j = 0; j < jobs; j++)
+        workers.emplace_back(work);
+    for (std::thread& worker : workers)
+        worker.join();
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    size_t passed = std::count_if(results.begin(), results.end(),
+        [](const TestResult& result) { return result.outcome == OutcomePassed; });
+    std::printf("%zu/%zu passed in %.2fs\n", passed, results.size(), seconds);
+
+    try {
+        if (junitPath)
+            WriteJUnit(junitPath, results, seconds);
+        if (jsonPath)
+            WriteJSON(jsonPath, results, seconds);
+    } catch (std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return -1;
+    }
+
+    return passed == results.size() ? 0 : 1;
+}
@@ -0,0 +1,34 @@
+#include <iostream>
+#include <cstdio>
+
+#include "cpu/Instruction.hpp"
+#include "trace/Trace.hpp"
+
+int main(int argc, char *argv[])
+{
+    if (argc != 2) {
+        std::cout << "usage: ./TraceDump <trace file>" << std::endl;
+        return 0;
+    }
+
+    try {
+        GameBoy::TraceReader trace(argv[1]);
+        GameBoy::TraceRecord record;
+        char mnemonic[GameBoy::Instruction::MaxStringLength];
+
+        while (trace.Next(record)) {
+            GameBoy::Instruction instr = GameBoy::Instruction::Decode(record.bytecode);
+            instr.Disassemble(mnemonic, sizeof(mnemonic));
+
+            std::printf("%10llu %04X: %-16s A:%02X F:%02X B:%02X C:%02X D:%02X E:%02X H:%02X L:%02X SP:%04X\n",
+                        static_cast<unsigned long long>(record.cycles), record.pc, mnemonic,
+                        record.a, record.f, record.b, record.c,
+                        record.d, record.e, record.h, record.l, record.sp);
+        }
+    } catch (std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,162 @@
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "trace/ReferenceTrace.hpp"
+
+namespace GameBoy
+{
+
+ReferenceTrace::ReferenceTrace(const std::string& path)
+: data(nullptr), size(0), offset(0), chunkEnd(0), index(0)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error("Cannot open reference trace");
+
+    struct stat st;
+    if (fstat(fd, &st) < 0 || st.st_size == 0) {
+        close(fd);
+        throw std::runtime_error("Empty reference trace");
+    }
+
+    void *mapping = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED)
+        throw std::runtime_error("Cannot map reference trace");
+
+    /* Read once from start to end, let the kernel read ahead aggressively */
+    madvise(mapping, st.st_size, MADV_SEQUENTIAL);
+
+    this->data = static_cast<const uint8_t*>(mapping);
+    this->size = st.st_size;
+
+    const TraceHeader *header = reinterpret_cast<const TraceHeader*>(this->data);
+    if (this->size >= sizeof(TraceHeader) && std::memcmp(header->magic, "GBTR", 4) == 0) {
+        const char *error = nullptr;
+        if (header->recordSize != sizeof(TraceRecord))
+            error = "Unsupported trace version";
+        else if (header->flags & TraceCompressed)
+            error = "Compressed traces cannot be used as reference";
+
+        if (error) {
+            munmap(mapping, st.st_size);
+            throw std::runtime_error(error);
+        }
+
+        this->format = FormatBinary;
+        /* Pretend a record ends where the header does to enter the first chunk */
+        this->chunkEnd = sizeof(TraceHeader);
+        this->offset = this->NextOffset(sizeof(TraceHeader) - sizeof(TraceRecord), this->chunkEnd);
+    } else {
+        this->format = FormatDoctor;
+    }
+}
+
+ReferenceTrace::~ReferenceTrace()
+{
+    munmap(const_cast<uint8_t*>(this->data), this->size);
+}
+
+size_t ReferenceTrace::NextOffset(size_t offset, size_t& chunkEnd) const
+{
+    if (this->format == FormatDoctor) {
+        const void *eol = std::memchr(this->data + offset, '\n', this->size - offset);
+        if (!eol)
+            return this->size;
+        return static_cast<const uint8_t*>(eol) - this->data + 1;
+    }
+
+    offset += sizeof(TraceRecord);
+    if (offset < chunkEnd)
+        return offset;
+
+    /* Skip the header of the next chunk */
+    if (this->size - offset < sizeof(TraceChunkHeader))
+        return this->size;
+
+    TraceChunkHeader chunk;
+    std::memcpy(&chunk, this->data + offset, sizeof(chunk));
+    offset += sizeof(chunk);
+    chunkEnd = offset + chunk.payloadSize;
+
+    if (chunkEnd > this->size || chunk.payloadSize != chunk.nRecords * sizeof(TraceRecord))
+        throw std::runtime_error("Corrupted reference trace");
+
+    return offset;
+}
+
+bool ReferenceTrace::PrintEntry(FILE *out, uint64_t n) const
+{
+    size_t offset = this->offset;
+    size_t chunkEnd = this->chunkEnd;
+
+    for (uint64_t i = 0; i < n && offset < this->size; i++)
+        offset = this->NextOffset(offset, chunkEnd);
+
+    if (offset >= this->size)
+        return false;
+
+    if (this->format == FormatDoctor) {
+        size_t length = this->NextOffset(offset, chunkEnd) - offset;
+        std::fwrite(this->data + offset, 1, length, out);
+        if (this->data[offset + length - 1] != '\n')
+            std::fputc('\n', out);
+        return true;
+    }
+
+    TraceRecord record;
+    std::memcpy(&record, this->data + offset, sizeof(record));
+
+    char line[DoctorLineLength + 1];
+    uint8_t pcmem[4] = { record.bytecode[0], record.bytecode[1], record.bytecode[2], 0 };
+    FormatDoctorLine(record, pcmem, line);
+
+    /* The fourth byte at PC is not recorded in binary traces */
+    line[DoctorLineLength - 3] = '\0';
+    std::fprintf(out, "%s CYCLES:%llu\n", line, static_cast<unsigned long long>(record.cycles));
+    return true;
+}
+
+static inline char *FormatHex(char *out, uint32_t value, int digits)
+{
+    static const char hex[] = "0123456789ABCDEF";
+
+    for (int i = digits - 1; i >= 0; i--) {
+        out[i] = hex[value & 0xf];
+        value >>= 4;
+    }
+    return out + digits;
+}
+
+static inline char *FormatField(char *out, const char *name, uint32_t value, int digits)
+{
+    while (*name)
+        *out++ = *name++;
+    return FormatHex(out, value, digits);
+}
+
+void ReferenceTrace::FormatDoctorLine(const TraceRecord& state, const uint8_t *pcmem, char *line)
+{
+    char *out = line;
+
+    out = FormatField(out, "A:", state.a, 2);
+    out = FormatField(out, " F:", state.f, 2);
+    out = FormatField(out, " B:", state.b, 2);
+    out = FormatField(out, " C:", state.c, 2);
+    out = FormatField(out, " D:", state.d, 2);
+    out = FormatField(out, " E:", state.e, 2);
+    out = FormatField(out, " H:", state.h, 2);
+    out = FormatField(out, " L:", state.l, 2);
+    out = FormatField(out, " SP:", state.sp, 4);
+    out = FormatField(out, " PC:", state.pc, 4);
+    out = FormatField(out, " PCMEM:", pcmem[0], 2);
+    out = FormatField(out, ",", pcmem[1], 2);
+    out = FormatField(out, ",", pcmem[2], 2);
+    out = FormatField(out, ",", pcmem[3], 2);
+}
+
+};
@@ -0,0 +1,181 @@
+#include <cstring>
+#include <stdexcept>
+
+#include "trace/Replay.hpp"
+#include "Video.hpp"
+
+namespace GameBoy
+{
+
+static const char ReplayMagic[4] = { 'G', 'B', 'R', 'P' };
+/* 2 hashes banked windows bank by bank */
+static const uint16_t ReplayVersion = 2;
+
+/* Multiply-xorshift over 64-bit words, fast and good enough to tell states apart */
+static inline uint64_t Mix(uint64_t hash, uint64_t word)
+{
+    hash = (hash ^ word) * 0x9E3779B97F4A7C15ULL;
+    return hash ^ (hash >> 29);
+}
+
+static uint64_t HashBytes(uint64_t hash, const uint8_t *bytes)
+{
+    for (size_t i = 0; i < MemoryBanks::PageSize; i += sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, bytes + i, sizeof(word));
+        hash = Mix(hash, word);
+    }
+    return hash;
+}
+
+StateHasher::StateHasher(MemoryMap& mmap, const std::vector<MemoryBanks*>& banks)
+: mmap(mmap), banks(banks)
+{
+    std::memset(this->pageHashes, 0, sizeof(this->pageHashes));
+    std::memset(this->banked, 0, sizeof(this->banked));
+
+    for (MemoryBanks *window : this->banks) {
+        uint32_t pages = window->GetBankSize() / MemoryBanks::PageSize;
+        for (uint32_t page = 0; page < pages; page++)
+            this->banked[(window->GetWindow() >> 8) + page] = true;
+        this->bankHashes.emplace_back(window->GetBanks() * pages, 0);
+    }
+}
+
+uint64_t StateHasher::HashPage(uint8_t page) const
+{
+    uint8_t bytes[256];
+    uint16_t offset = 0;
+
+    /* Only HRAM in the I/O page, reading registers can have side effects */
+    if (page == 0xFF)
+        offset = 0x80;
+
+    /* Not to show up in memory access reports */
+    std::memset(bytes, 0xFF, sizeof(bytes));
+    this->mmap.Peek((page << 8) + offset, bytes + offset, sizeof(bytes) - offset);
+
+    return HashBytes(page, bytes);
+}
+
+uint64_t StateHasher::Hash(CPU& cpu)
+{
+    /* The dirty pages of a window are the banks' to take */
+    for (unsigned int page = 0; page < 256; page++) {
+        if (!this->banked[page] && this->mmap.TakeDirty(page))
+            this->pageHashes[page] = this->HashPage(page);
+    }
+
+    for (size_t i = 0; i < this->banks.size(); i++) {
+        MemoryBanks& window = *this->banks[i];
+        uint32_t pages = window.GetBankSize() / MemoryBanks::PageSize;
+
+        for (int bank = 0; bank < window.GetBanks(); bank++) {
+            for (uint32_t page = 0; page < pages; page++) {
+                if (!window.TakeDirty(bank, page))
+                    continue;
+
+                uint64_t seed = ((uint64_t) bank << 8) | ((window.GetWindow() >> 8) + page);
+                this->bankHashes[i][bank * pages + page] = HashBytes(seed, window.GetPage(bank, page));
+            }
+        }
+    }
+
+    const Registers& registers = cpu.GetRegisters();
+    uint64_t hash = Mix(0, cpu.GetCycles());
+    hash = Mix(hash, ((uint64_t) registers.GetAF() << 48) | ((uint64_t) registers.GetBC() << 32)
+                     | ((uint64_t) registers.GetDE() << 16) | registers.GetHL());
+    hash = Mix(hash, ((uint64_t) registers.sp << 16) | registers.pc);
+
+    for (uint64_t pageHash : this->pageHashes)
+        hash = Mix(hash, pageHash);
+
+    for (size_t i = 0; i < this->banks.size(); i++) {
+        hash = Mix(hash, this->banks[i]->GetCurrent());
+        for (uint64_t pageHash : this->bankHashes[i])
+            hash = Mix(hash, pageHash);
+    }
+    return hash;
+}
+
+ReplayLog::ReplayLog(MemoryMap& mmap, CPU& cpu, const std::vector<MemoryBanks*>& banks,
+                     const std::string& path, Mode mode, uint32_t interval)
+: cpu(cpu), hasher(mmap, banks), mode(mode), interval(interval),
+  frame(0), nCheckpoints(0), atEnd(false), diverged(false)
+{
+    ReplayHeader header;
+
+    if (mode == ModeRecord) {
+        if (interval == 0)
+            throw std::runtime_error("Replay interval must be at least one frame");
+
+        this->file = std::fopen(path.c_str(), "wb");
+        if (!this->file)
+            throw std::runtime_error("Cannot open replay file");
+
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, ReplayMagic, sizeof(header.magic));
+        header.version = ReplayVersion;
+        header.recordSize = sizeof(ReplayCheckpoint);
+        header.interval = interval;
+
+        if (std::fwrite(&header, sizeof(header), 1, this->file) != 1) {
+            std::fclose(this->file);
+            throw std::runtime_error("Cannot write replay file");
+        }
+    } else {
+        this->file = std::fopen(path.c_str(), "rb");
+        if (!this->file)
+            throw std::runtime_error("Cannot open replay file");
+
+        if (std::fread(&header, sizeof(header), 1, this->file) != 1
+            || std::memcmp(header.magic, ReplayMagic, sizeof(ReplayMagic)) != 0
+            || header.version != ReplayVersion || header.recordSize != sizeof(ReplayCheckpoint)
+            || header.interval == 0) {
+            std::fclose(this->file);
+            throw std::runtime_error("Not a supported replay file");
+        }
+
+        this->interval = header.interval;
+    }
+
+    this->eventId = this->cpu.GetScheduler().Register(this);
+    if (mode == ModeRecord || this->ReadExpected())
+        this->cpu.GetScheduler().Schedule(this->eventId, this->interval * Video::FrameCycles);
+}
+
+ReplayLog::~ReplayLog()
+{
+    this->cpu.GetScheduler().Cancel(this->eventId);
+    std::fclose(this->file);
+}
+
+bool ReplayLog::ReadExpected(void)
+{
+    if (std::fread(&this->expected, sizeof(this->expected), 1, this->file) != 1)
+        this->atEnd = true;
+    return !this->atEnd;
+}
+
+void ReplayLog::OnEvent(uint64_t deadline)
+{
+    this->frame += this->interval;
+    this->actual.frame = this->frame;
+    this->actual.cycles = this->cpu.GetCycles();
+    this->actual.hash = this->hasher.Hash(this->cpu);
+
+    if (this->mode == ModeRecord) {
+        if (std::fwrite(&this->actual, sizeof(this->actual), 1, this->file) != 1)
+            throw std::runtime_error("Cannot write replay file");
+    } else if (std::memcmp(&this->expected, &this->actual, sizeof(this->actual)) != 0) {
+        this->diverged = true;
+        return;
+    }
+
+    this->nCheckpoints++;
+    if (this->mode == ModeVerify && !this->ReadExpected())
+        return;
+    this->cpu.GetScheduler().Schedule(this->eventId, deadline + this->interval * Video::FrameCycles);
+}
+
+};
@@ -0,0 +1,205 @@
+#include <cstring>
+#include <stdexcept>
+
+#include "trace/Trace.hpp"
+
+namespace GameBoy
+{
+
+static const char TraceMagic[4] = { 'G', 'B', 'T', 'R' };
+static const uint16_t TraceVersion = 1;
+
+TraceWriter::TraceWriter(const std::string& path, bool compress, size_t capacity)
+: compress(compress), capacity(capacity), closing(false)
+{
+    this->file = std::fopen(path.c_str(), "wb");
+    if (!this->file)
+        throw std::runtime_error("Cannot open trace file");
+
+    TraceHeader header;
+    std::memcpy(header.magic, TraceMagic, sizeof(header.magic));
+    header.version = TraceVersion;
+    header.flags = compress ? TraceCompressed : 0;
+    header.recordSize = sizeof(TraceRecord);
+    header.reserved = 0;
+    std::fwrite(&header, sizeof(header), 1, this->file);
+
+    this->active.reserve(this->capacity);
+    this->worker = std::thread(&TraceWriter::Work, this);
+}
+
+TraceWriter::~TraceWriter()
+{
+    this->Close();
+}
+
+void TraceWriter::Submit(void)
+{
+    std::unique_lock<std::mutex> lock(this->mutex);
+
+    /* Backpressure: don't let the queue grow without bound */
+    this->cv.wait(lock, [this] { return this->pending.size() < MaxPending; });
+
+    this->pending.push_back(std::move(this->active));
+    if (this->spare.empty()) {
+        this->active = std::vector<TraceRecord>();
+        this->active.reserve(this->capacity);
+    } else {
+        this->active = std::move(this->spare.back());
+        this->spare.pop_back();
+    }
+
+    this->cv.notify_all();
+}
+
+void TraceWriter::Work(void)
+{
+    std::vector<uint8_t> payload;
+    std::unique_lock<std::mutex> lock(this->mutex);
+
+    while (true) {
+        this->cv.wait(lock, [this] { return !this->pending.empty() || this->closing; });
+        if (this->pending.empty())
+            break;
+
+        std::vector<TraceRecord> records = std::move(this->pending.front());
+        this->pending.pop_front();
+        lock.unlock();
+
+        this->WriteChunk(records, payload);
+        records.clear();
+
+        lock.lock();
+        this->spare.push_back(std::move(records));
+        this->cv.notify_all();
+    }
+}
+
+void TraceWriter::WriteChunk(const std::vector<TraceRecord>& records, std::vector<uint8_t>& payload)
+{
+    if (records.empty())
+        return;
+
+    TraceChunkHeader chunk;
+    chunk.nRecords = records.size();
+
+    if (!this->compress) {
+        chunk.payloadSize = records.size() * sizeof(TraceRecord);
+        std::fwrite(&chunk, sizeof(chunk), 1, this->file);
+        std::fwrite(records.data(), sizeof(TraceRecord), records.size(), this->file);
+        return;
+    }
+
+    payload.resize(records.size() * (3 + sizeof(TraceRecord)));
+    uint8_t *out = payload.data();
+
+    uint8_t previous[sizeof(TraceRecord)] = { 0 };
+    for (const TraceRecord& record : records) {
+        const uint8_t *bytes = reinterpret_cast<const uint8_t*>(&record);
+
+        uint8_t *mask = out;
+        out += 3;
+        mask[0] = mask[1] = mask[2] = 0;
+
+        for (size_t i = 0; i < sizeof(TraceRecord); i++) {
+            if (bytes[i] != previous[i]) {
+                mask[i / 8] |= (1 << (i % 8));
+                *out++ = bytes[i];
+            }
+        }
+
+        std::memcpy(previous, bytes, sizeof(previous));
+    }
+
+    chunk.payloadSize = out - payload.data();
+    std::fwrite(&chunk, sizeof(chunk), 1, this->file);
+    std::fwrite(payload.data(), 1, chunk.payloadSize, this->file);
+}
+
+void TraceWriter::Close(void)
+{
+    if (!this->file)
+        return;
+
+    {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->pending.push_back(std::move(this->active));
+        this->closing = true;
+        this->cv.notify_all();
+    }
+
+    this->worker.join();
+
+    std::fclose(this->file);
+    this->file = nullptr;
+}
+
+TraceReader::TraceReader(const std::string& path) : position(0)
+{
+    this->file = std::fopen(path.c_str(), "rb");
+    if (!this->file)
+        throw std::runtime_error("Cannot open trace file");
+
+    if (std::fread(&this->header, sizeof(this->header), 1, this->file) != 1
+        || std::memcmp(this->header.magic, TraceMagic, sizeof(TraceMagic)) != 0) {
+        std::fclose(this->file);
+        throw std::runtime_error("Not a trace file");
+    }
+
+    if (this->header.version != TraceVersion || this->header.recordSize != sizeof(TraceRecord)) {
+        std::fclose(this->file);
+        throw std::runtime_error("Unsupported trace version");
+    }
+}
+
+TraceReader::~TraceReader()
+{
+    std::fclose(this->file);
+}
+
+bool TraceReader::ReadChunk(void)
+{
+    TraceChunkHeader chunk;
+    if (std::fread(&chunk, sizeof(chunk), 1, this->file) != 1)
+        return false;
+
+    this->payload.resize(chunk.payloadSize);
+    if (std::fread(this->payload.data(), 1, chunk.payloadSize, this->file) != chunk.payloadSize)
+        throw std::runtime_error("Truncated trace file");
+
+    this->records.resize(chunk.nRecords);
+    this->position = 0;
+
+    if (!this->IsCompressed()) {
+        if (chunk.payloadSize != chunk.nRecords * sizeof(TraceRecord))
+            throw std::runtime_error("Corrupted trace chunk");
+        std::memcpy(this->records.data(), this->payload.data(), chunk.payloadSize);
+        return chunk.nRecords > 0;
+    }
+
+    const uint8_t *in = this->payload.data();
+    const uint8_t *end = in + chunk.payloadSize;
+
+    uint8_t previous[sizeof(TraceRecord)] = { 0 };
+    for (TraceRecord& record : this->records) {
+        if (end - in < 3)
+            throw std::runtime_error("Corrupted trace chunk");
+
+        const uint8_t *mask = in;
+        in += 3;
+
+        for (size_t i = 0; i < sizeof(TraceRecord); i++) {
+            if (mask[i / 8] & (1 << (i % 8))) {
+                if (in == end)
+                    throw std::runtime_error("Corrupted trace chunk");
+                previous[i] = *in++;
+            }
+        }
+
+        std::memcpy(&record, previous, sizeof(previous));
+    }
+
+    return chunk.nRecords > 0;
+}
+
+};